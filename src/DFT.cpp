@@ -0,0 +1,404 @@
+#include <vector>
+#include <map>
+#include <complex>
+#include <mutex>
+#include <memory>
+#include <cmath>
+#include <algorithm>
+#include <Rcpp.h>
+#include "DFT.h"
+using namespace Rcpp;
+
+typedef std::complex<double> cplx;
+
+// Plans of transforms are computed once for every length and shared by all
+// series (and threads) of the same length. At most PLAN_CACHE_SIZE plans of
+// every type are kept, the least recently used one is dropped by the insertion
+// of a new one (plans in use are kept alive by their shared pointers).
+static const size_t PLAN_CACHE_SIZE = 64;
+
+template <class Plan>
+static std::shared_ptr<const Plan> cached_plan(int n) {
+  typedef std::pair<std::shared_ptr<const Plan>, unsigned long long> entry;
+  static std::map<int, entry> plans;
+  static unsigned long long clock = 0;
+  static std::mutex plans_mutex;
+
+  {
+    std::lock_guard<std::mutex> lock(plans_mutex);
+    typename std::map<int, entry>::iterator plan = plans.find(n);
+    if (plan != plans.end()) {
+      plan->second.second = ++clock;
+      return plan->second.first;
+    }
+  }
+
+  // the plan is created without the lock, as it can use plans of other lengths
+  std::shared_ptr<const Plan> plan(new Plan(n));
+
+  std::lock_guard<std::mutex> lock(plans_mutex);
+
+  typename std::map<int, entry>::iterator found = plans.find(n);
+  if (found != plans.end()) {
+    found->second.second = ++clock;
+    return found->second.first;
+  }
+
+  if (plans.size() >= PLAN_CACHE_SIZE) {
+    typename std::map<int, entry>::iterator oldest = plans.begin();
+    for(typename std::map<int, entry>::iterator it = plans.begin(); it != plans.end(); ++it){
+      if (it->second.second < oldest->second.second) {
+        oldest = it;
+      }
+    }
+    plans.erase(oldest);
+  }
+
+  plans.insert(std::make_pair(n, entry(plan, ++clock)));
+
+  return plan;
+}
+
+// Twiddle factors exp(-2*pi*i*k/n) for k = 0, ..., n-1
+class Twiddles {
+public:
+  std::vector<cplx> w;
+
+  explicit Twiddles(int n) : w(n) {
+    for(int k = 0; k < n; k++){
+      double angle = -2 * M_PI * k / n;
+      w[k] = cplx(std::cos(angle), std::sin(angle));
+    }
+  }
+};
+
+static bool power_of_two(int n) {
+  return (n & (n - 1)) == 0;
+}
+
+// Complex FFT of the length n, powers of two by the iterative radix-2
+// algorithm, other lengths by the Bluestein algorithm (the convolution
+// with the chirp computed by FFT of the power of two length)
+class FftPlan {
+public:
+  explicit FftPlan(int n) : n(n), m(0) {
+
+    if (power_of_two(n)) {
+      int bits = 0;
+      while ((1 << bits) < n) {
+        bits++;
+      }
+      rev.resize(n);
+      for(int i = 0; i < n; i++){
+        int r = 0;
+        for(int b = 0; b < bits; b++){
+          r |= ((i >> b) & 1) << (bits - 1 - b);
+        }
+        rev[i] = r;
+      }
+      twiddles.resize(n / 2);
+      for(int k = 0; k < n / 2; k++){
+        double angle = -2 * M_PI * k / n;
+        twiddles[k] = cplx(std::cos(angle), std::sin(angle));
+      }
+      return;
+    }
+
+    m = 1;
+    while (m < (2 * n) - 1) {
+      m <<= 1;
+    }
+    inner = cached_plan<FftPlan>(m);
+
+    // chirp exp(-pi*i*k^2/n), k^2 is reduced modulo 2n for the precision
+    chirp.resize(n);
+    for(int k = 0; k < n; k++){
+      long long k2 = ((long long) k * k) % (2LL * n);
+      double angle = -M_PI * k2 / n;
+      chirp[k] = cplx(std::cos(angle), std::sin(angle));
+    }
+
+    filter.assign(m, cplx(0, 0));
+    filter[0] = std::conj(chirp[0]);
+    for(int k = 1; k < n; k++){
+      filter[k] = filter[m - k] = std::conj(chirp[k]);
+    }
+    inner->forward(filter.data());
+  }
+
+  // in place forward transform of n values
+  void forward(cplx* x) const {
+    if (m == 0) {
+      radix2(x);
+    } else {
+      bluestein(x);
+    }
+  }
+
+private:
+  int n, m;
+  std::vector<int> rev;
+  std::vector<cplx> twiddles, chirp, filter;
+  std::shared_ptr<const FftPlan> inner;
+
+  void radix2(cplx* x) const {
+    for(int i = 0; i < n; i++){
+      if (i < rev[i]) {
+        std::swap(x[i], x[rev[i]]);
+      }
+    }
+
+    for(int len = 2; len <= n; len <<= 1){
+      int half = len / 2, step = n / len;
+      for(int i = 0; i < n; i += len){
+        for(int j = 0; j < half; j++){
+          cplx u = x[i + j], v = x[i + j + half] * twiddles[j * step];
+          x[i + j] = u + v;
+          x[i + j + half] = u - v;
+        }
+      }
+    }
+  }
+
+  void bluestein(cplx* x) const {
+    std::vector<cplx> a(m, cplx(0, 0));
+
+    for(int k = 0; k < n; k++){
+      a[k] = x[k] * chirp[k];
+    }
+
+    inner->forward(a.data());
+
+    // inverse transform by the forward one of the conjugate
+    for(int k = 0; k < m; k++){
+      a[k] = std::conj(a[k] * filter[k]);
+    }
+
+    inner->forward(a.data());
+
+    for(int k = 0; k < n; k++){
+      x[k] = chirp[k] * std::conj(a[k]) / (double) m;
+    }
+  }
+};
+
+// FFT of real values of the length n by the complex FFT of the length n/2
+// (even and odd values as real and imaginary parts) for even lengths
+class RealFftPlan {
+public:
+  explicit RealFftPlan(int n) : n(n) {
+    if (n % 2 == 0) {
+      half = cached_plan<FftPlan>(n / 2);
+      twiddles.resize((n / 2) + 1);
+      for(int k = 0; k <= n / 2; k++){
+        double angle = -2 * M_PI * k / n;
+        twiddles[k] = cplx(std::cos(angle), std::sin(angle));
+      }
+    } else {
+      full = cached_plan<FftPlan>(n);
+    }
+  }
+
+  // bins 0, ..., n/2 of DFT of x
+  void forward(const double* x, cplx* bins) const {
+
+    if (n % 2 == 1) {
+      std::vector<cplx> z(x, x + n);
+      full->forward(z.data());
+      std::copy(z.begin(), z.begin() + (n / 2) + 1, bins);
+      return;
+    }
+
+    int h = n / 2;
+    std::vector<cplx> z(h);
+
+    for(int j = 0; j < h; j++){
+      z[j] = cplx(x[2 * j], x[(2 * j) + 1]);
+    }
+
+    half->forward(z.data());
+
+    for(int k = 0; k <= h; k++){
+      cplx zk = z[k % h], zc = std::conj(z[(h - k) % h]);
+      cplx even = (zk + zc) * 0.5;
+      cplx odd = (zk - zc) * cplx(0, -0.5);
+      bins[k] = even + (twiddles[k] * odd);
+    }
+  }
+
+private:
+  int n;
+  std::shared_ptr<const FftPlan> half, full;
+  std::vector<cplx> twiddles;
+};
+
+// Leading bins are computed directly from the table of twiddles (pruned DFT)
+// when their number is at most log2(n), otherwise by the real FFT
+static bool pruned(int n, int coef) {
+  int log2n = 0;
+  while ((1 << log2n) < n) {
+    log2n++;
+  }
+  return coef <= log2n;
+}
+
+// Leading coef bins of DFT of x
+void dft_bins(const double* x, int n, int coef, cplx* bins) {
+
+  if (pruned(n, coef)) {
+    const std::vector<cplx>& w = cached_plan<Twiddles>(n)->w;
+
+    for(int k = 0; k < coef; k++){
+      double re = 0, im = 0;
+      for(int j = 0, idx = 0; j < n; j++){
+        re += x[j] * w[idx].real();
+        im += x[j] * w[idx].imag();
+        idx += k;
+        if (idx >= n) {
+          idx -= n;
+        }
+      }
+      bins[k] = cplx(re, im);
+    }
+    return;
+  }
+
+  std::vector<cplx> half_bins((n / 2) + 1);
+  cached_plan<RealFftPlan>(n)->forward(x, half_bins.data());
+
+  for(int k = 0; k < coef; k++){
+    bins[k] = k <= n / 2 ? half_bins[k] : std::conj(half_bins[n - k]);
+  }
+}
+
+// Coefficients (real parts followed by imaginary parts) or the reconstruction
+// of the length coef from leading coef bins of DFT, bins are overwritten
+void dft_output(cplx* bins, int coef, bool coefficients, double* repr) {
+
+  if (coefficients) {
+    for(int k = 0; k < coef; k++){
+      repr[k] = bins[k].real();
+      repr[coef + k] = bins[k].imag();
+    }
+    return;
+  }
+
+  // real part of the inverse DFT of the length coef,
+  // by the forward transform of the conjugate
+  for(int k = 0; k < coef; k++){
+    bins[k] = std::conj(bins[k]);
+  }
+
+  cached_plan<FftPlan>(coef)->forward(bins);
+
+  for(int k = 0; k < coef; k++){
+    repr[k] = bins[k].real() / coef;
+  }
+}
+
+void dft_kernel(const double* x, int n, int coef, bool coefficients, double* repr) {
+
+  int n_repr = coefficients ? 2 * coef : coef;
+
+  if (coef > n) {
+    std::fill(repr, repr + n_repr, NA_REAL);
+    return;
+  }
+
+  std::vector<cplx> bins(coef);
+  dft_bins(x, n, coef, bins.data());
+
+  dft_output(bins.data(), coef, coefficients, repr);
+}
+
+void dct_kernel(const double* x, int n, int coef, bool coefficients, double* repr) {
+
+  if (coef > n) {
+    std::fill(repr, repr + coef, NA_REAL);
+    return;
+  }
+
+  // exp(-2*pi*i*m/(4n)), cos(pi*k*(2j+1)/(2n)) is the real part of w[k*(2j+1) mod 4n]
+  const std::vector<cplx>& w = cached_plan<Twiddles>(4 * n)->w;
+  std::vector<double> dct(coef);
+
+  if (pruned(n, coef)) {
+
+    for(int k = 0; k < coef; k++){
+      double sum = 0;
+      for(int j = 0, idx = k; j < n; j++){
+        sum += x[j] * w[idx].real();
+        idx += 2 * k;
+        if (idx >= 4 * n) {
+          idx -= 4 * n;
+        }
+      }
+      dct[k] = sum;
+    }
+
+  } else {
+
+    // DCT-II by DFT of the reordered series (even values, then odd values reversed)
+    std::vector<double> v(n);
+    for(int j = 0; 2 * j < n; j++){
+      v[j] = x[2 * j];
+    }
+    for(int j = 0; (2 * j) + 1 < n; j++){
+      v[n - 1 - j] = x[(2 * j) + 1];
+    }
+
+    std::vector<cplx> bins(coef);
+    dft_bins(v.data(), n, coef, bins.data());
+
+    for(int k = 0; k < coef; k++){
+      dct[k] = (w[k] * bins[k]).real();
+    }
+  }
+
+  if (coefficients) {
+    std::copy(dct.begin(), dct.end(), repr);
+    return;
+  }
+
+  // inverse DCT of the length coef by the inverse DFT of the length coef
+  const std::vector<cplx>& wc = cached_plan<Twiddles>(4 * coef)->w;
+  std::vector<cplx> bins(coef);
+
+  for(int k = 0; k < coef; k++){
+    cplx c(dct[k], k == 0 ? 0 : -dct[coef - k]);
+    // conjugate of exp(pi*i*k/(2coef)) * c for the inverse by the forward transform
+    bins[k] = std::conj(std::conj(wc[k]) * c);
+  }
+
+  cached_plan<FftPlan>(coef)->forward(bins.data());
+
+  for(int j = 0; 2 * j < coef; j++){
+    repr[2 * j] = bins[j].real() / coef;
+  }
+  for(int j = 0; (2 * j) + 1 < coef; j++){
+    repr[(2 * j) + 1] = bins[coef - 1 - j].real() / coef;
+  }
+}
+
+// DFT or DCT of x computed by dft_kernel or dct_kernel
+// [[Rcpp::export]]
+NumericVector fourier_native(NumericVector x, int coef, std::string type, bool coefficients) {
+
+  if (coef < 1) {
+    Rcpp::stop("coef must be positive!");
+  }
+  if (type != "dft" && type != "dct") {
+    Rcpp::stop("type must be \"dft\" or \"dct\"!");
+  }
+
+  if (type == "dft") {
+    NumericVector repr(coefficients ? 2 * coef : coef);
+    dft_kernel(x.begin(), x.size(), coef, coefficients, repr.begin());
+    return repr;
+  }
+
+  NumericVector repr(coef);
+  dct_kernel(x.begin(), x.size(), coef, coefficients, repr.begin());
+
+  return repr;
+}
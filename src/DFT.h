@@ -0,0 +1,19 @@
+#ifndef TSREPR_DFT_H
+#define TSREPR_DFT_H
+
+#include <complex>
+#include <Rcpp.h>
+using namespace Rcpp;
+
+// Leading coef coefficients of DFT (real parts followed by imaginary parts)
+// or DCT-II of x, or time series of the length coef reconstructed from them
+// (by the inverse DFT or DCT of the length coef). Representation of series
+// shorter than coef is NA.
+void dft_kernel(const double* x, int n, int coef, bool coefficients, double* repr);
+void dct_kernel(const double* x, int n, int coef, bool coefficients, double* repr);
+
+// leading coef (at most n) bins of DFT of x and the representation from them
+void dft_bins(const double* x, int n, int coef, std::complex<double>* bins);
+void dft_output(std::complex<double>* bins, int coef, bool coefficients, double* repr);
+
+#endif
@@ -0,0 +1,126 @@
+#include <vector>
+#include <cmath>
+#include <algorithm>
+#include <Rcpp.h>
+#include "DWT.h"
+using namespace Rcpp;
+
+// Scaling filters of the most used wavelets (as wavelets::wt.filter(filter)@g)
+static const double haar_filter[] = {0.7071067811865475, 0.7071067811865475};
+static const double d4_filter[] = {0.4829629131445341, 0.8365163037378077, 0.2241438680420134,
+                                   -0.1294095225512603};
+static const double d6_filter[] = {0.3326705529500827, 0.8068915093110928, 0.4598775021184915,
+                                   -0.1350110200102546, -0.0854412738820267, 0.0352262918857096};
+
+int dwt_size(int n, int level) {
+  for(int j = 0; j < level; j++){
+    n /= 2;
+  }
+  return n;
+}
+
+// Scaling filter given by its coefficients or by its name, filters other than
+// "haar", "d4" and "d6" are taken once from the wavelets package
+std::vector<double> dwt_filter(SEXP filter) {
+
+  if (TYPEOF(filter) == REALSXP) {
+    NumericVector coefs(filter);
+    return std::vector<double>(coefs.begin(), coefs.end());
+  }
+
+  std::string name = Rcpp::as<std::string>(filter);
+
+  if (name == "haar") {
+    return std::vector<double>(haar_filter, haar_filter + 2);
+  } else if (name == "d4") {
+    return std::vector<double>(d4_filter, d4_filter + 4);
+  } else if (name == "d6") {
+    return std::vector<double>(d6_filter, d6_filter + 6);
+  }
+
+  Environment pkg = Environment::namespace_env("TSrepr");
+  Function scaling_filter = pkg.get("dwt_scaling_filter");
+  NumericVector coefs = scaling_filter(name);
+
+  return std::vector<double>(coefs.begin(), coefs.end());
+}
+
+// One level of the pyramid algorithm with the periodic boundary,
+// only approximation (scaling) coefficients are computed:
+// v_t = sum_l g_l x_{(2t + 1 - l) mod n}, t = 0, ..., n/2 - 1
+static void dwt_level(const double* x, int n, const std::vector<double>& filter, double* v) {
+
+  int n_v = n / 2, len = filter.size();
+  const double* g = filter.data();
+
+  if (len == 2) {
+    for(int t = 0; t < n_v; t++){
+      v[t] = (g[0] * x[(2 * t) + 1]) + (g[1] * x[2 * t]);
+    }
+    return;
+  }
+
+  // first outputs wrap around the start of x (possibly several times for
+  // short x), the rest is computed without the modulo
+  int t = 0;
+  for(; t < n_v && (2 * t) + 1 < len - 1; t++){
+    double sum = 0;
+    int u = (2 * t) + 1;
+    for(int l = 0; l < len; l++){
+      sum += g[l] * x[u];
+      u = u == 0 ? n - 1 : u - 1;
+    }
+    v[t] = sum;
+  }
+  for(; t < n_v; t++){
+    const double* xu = x + (2 * t) + 1;
+    double sum = 0;
+    for(int l = 0; l < len; l++){
+      sum += g[l] * xu[-l];
+    }
+    v[t] = sum;
+  }
+}
+
+// Approximation coefficients of the level of DWT of x, levels are computed
+// alternately to two halves of the scratch buffer of the length n, the last
+// one directly to repr
+void dwt_kernel(const double* x, int n, int level, const std::vector<double>& filter,
+                double* scratch, double* repr) {
+
+  if (dwt_size(n, level) == 0) {
+    return;
+  }
+
+  const double* in = x;
+  int n_in = n;
+
+  for(int j = 1; j <= level; j++){
+    double* out = j == level ? repr : scratch + (j % 2 == 1 ? 0 : n / 2);
+    dwt_level(in, n_in, filter, out);
+    in = out;
+    n_in /= 2;
+  }
+}
+
+// DWT approximation coefficients of the level of x
+// [[Rcpp::export]]
+NumericVector dwt_native(NumericVector x, int level, SEXP filter) {
+
+  int n = x.size();
+
+  if (level < 1) {
+    Rcpp::stop("level must be positive!");
+  }
+  if (dwt_size(n, level) == 0) {
+    Rcpp::stop("level is too high for the length of x!");
+  }
+
+  std::vector<double> coefs = dwt_filter(filter);
+  std::vector<double> scratch(n);
+  NumericVector repr(dwt_size(n, level));
+
+  dwt_kernel(x.begin(), n, level, coefs, scratch.data(), repr.begin());
+
+  return repr;
+}
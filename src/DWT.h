@@ -0,0 +1,15 @@
+#ifndef TSREPR_DWT_H
+#define TSREPR_DWT_H
+
+#include <vector>
+#include <Rcpp.h>
+using namespace Rcpp;
+
+// the length of DWT approximation coefficients of the level of a series of the length n
+int dwt_size(int n, int level);
+
+std::vector<double> dwt_filter(SEXP filter);
+void dwt_kernel(const double* x, int n, int level, const std::vector<double>& filter,
+                double* scratch, double* repr);
+
+#endif
@@ -4,8 +4,244 @@
 #include "helpers.h"
 #include "rle.h"
 #include "reprsClassical.h"
+#include "FeatureClippingTrending.h"
 using namespace Rcpp;
 
+void feaclip_kernel(const double* x, int n, double* repr) {
+  feaclip_runs(x, n, std::accumulate(x, x + n, 0.0) / n, repr);
+}
+
+// FeaClip features of n values of x computed by one pass through the clipped
+// series after the mean, run lengths of ones and zeros are not stored
+void feaclip_runs(const double* x, int n, double x_mean, double* repr) {
+
+  int max_1 = 0, sum_1 = 0, max_0 = 0, n_runs = 0;
+  int first_value = x[0] > x_mean, first_length = 0;
+  int value = first_value, length = 0;
+
+  for(int i = 0; i < n; ++i) {
+    int bit = x[i] > x_mean;
+
+    if (bit == value) {
+      length++;
+    } else {
+      if (n_runs == 0) {
+        first_length = length;
+      }
+      if (value == 1) {
+        max_1 = std::max(max_1, length);
+        sum_1 += length;
+      } else {
+        max_0 = std::max(max_0, length);
+      }
+
+      n_runs++;
+      value = bit;
+      length = 1;
+    }
+  }
+
+  // the last run
+  if (n_runs == 0) {
+    first_length = length;
+  }
+  if (value == 1) {
+    max_1 = std::max(max_1, length);
+    sum_1 += length;
+  } else {
+    max_0 = std::max(max_0, length);
+  }
+  n_runs++;
+
+  repr[0] = max_1;
+  repr[1] = sum_1;
+  repr[2] = max_0;
+  repr[3] = n_runs - 1;
+  repr[4] = first_value == 0 ? first_length : 0;
+  repr[5] = value == 0 ? length : 0;
+  repr[6] = first_value == 1 ? first_length : 0;
+  repr[7] = value == 1 ? length : 0;
+}
+
+// Aggregation of run lengths of one value, max, sum, mean and min are computed
+// from running statistics, other aggregations from stored run lengths
+class RunAggregation {
+public:
+  explicit RunAggregation(Aggregation aggr)
+    : aggr(aggr), streaming(aggr == aggr_max || aggr == aggr_sum || aggr == aggr_mean || aggr == aggr_min) {
+    clear();
+  }
+
+  void clear() {
+    count = sum = max = 0;
+    min = 0;
+    lengths.clear();
+  }
+
+  void add(int length) {
+    min = count == 0 ? length : std::min(min, length);
+    max = std::max(max, length);
+    sum += length;
+    count++;
+    if (!streaming) {
+      lengths.push_back(length);
+    }
+  }
+
+  // aggregation of run lengths, 0 if there are no runs
+  double value() const {
+    if (count == 0) {
+      return 0;
+    }
+    if (aggr == aggr_max) {
+      return max;
+    } else if (aggr == aggr_sum) {
+      return sum;
+    } else if (aggr == aggr_mean) {
+      return (double) sum / count;
+    } else if (aggr == aggr_min) {
+      return min;
+    }
+    return aggr(lengths.data(), count);
+  }
+
+private:
+  Aggregation aggr;
+  bool streaming;
+  int count, sum, max, min;
+  std::vector<double> lengths;
+};
+
+// Runs of trending of pieces of n_ma SMA values added one by one, features
+// of a piece are written to repr when the piece is complete
+class TrendRuns {
+public:
+  TrendRuns(int n_ma, int pieces, Aggregation aggr, double* repr)
+    : pieces(pieces), n_piece(n_ma / pieces), k(0), value(-1), length(0), prev(0),
+      repr(repr), ones(aggr), zeros(aggr) {}
+
+  // the number of SMA values used by pieces
+  int size() const {
+    return pieces * n_piece;
+  }
+
+  void add(double sma) {
+    if (k % n_piece == 0) {
+      if (k > 0) {
+        write((k / n_piece) - 1);
+      }
+      value = -1;
+      length = 0;
+    } else {
+      int bit = (prev - sma) < 0;
+      if (bit == value) {
+        length++;
+      } else {
+        push();
+        value = bit;
+        length = 1;
+      }
+    }
+    prev = sma;
+    k++;
+  }
+
+  // writes features of the last piece (or of all pieces without values)
+  void finish() {
+    if (n_piece == 0) {
+      std::fill(repr, repr + (pieces * 2), 0.0);
+    } else if (k > 0) {
+      write((k - 1) / n_piece);
+    }
+  }
+
+private:
+  int pieces, n_piece, k, value, length;
+  double prev;
+  double* repr;
+  RunAggregation ones, zeros;
+
+  void push() {
+    if (length > 0) {
+      (value == 1 ? ones : zeros).add(length);
+    }
+  }
+
+  void write(int j) {
+    push();
+    repr[j*2] = ones.value();
+    repr[j*2 + 1] = zeros.value();
+    ones.clear();
+    zeros.clear();
+  }
+};
+
+void featrend_kernel(const double* x, int n, int pieces, int order, Aggregation aggr, double* repr) {
+
+  int n_ma = n - order;
+
+  if (n_ma < 1) {
+    std::fill(repr, repr + (pieces * 2), NA_REAL);
+    return;
+  }
+
+  TrendRuns runs(n_ma, pieces, aggr, repr);
+
+  // SMA values are computed by the same recurrence as sma_kernel
+  double sma = 0;
+  for(int i = 0; i < order; i++){
+    sma += x[i];
+  }
+  sma = sma / order;
+
+  for(int k = 0; k < runs.size(); k++){
+    if (k > 0) {
+      sma = sma + (x[k+order]/order) - (x[k-1]/order);
+    }
+    runs.add(sma);
+  }
+
+  runs.finish();
+}
+
+// FeaClipTrend by two sweeps of x, the first one computes the sum of values
+// and SMA values (the value k when x[k + order] is read) with trending runs,
+// the second one computes clipping runs after the mean
+void feacliptrend_kernel(const double* x, int n, int pieces, int order, Aggregation aggr, double* repr) {
+
+  int n_ma = n - order;
+
+  if (n_ma < 1) {
+    std::fill(repr, repr + 8 + (pieces * 2), NA_REAL);
+    return;
+  }
+
+  TrendRuns runs(n_ma, pieces, aggr, repr + 8);
+  int n_used = runs.size();
+  double sum = 0, sma = 0;
+
+  for(int i = 0; i < n; i++){
+    sum += x[i];
+
+    if (i < order) {
+      sma += x[i];
+      if (i == order - 1) {
+        sma = sma / order;
+        if (n_used > 0) {
+          runs.add(sma);
+        }
+      }
+    } else if (i > order && i - order < n_used) {
+      int k = i - order;
+      sma = sma + (x[i]/order) - (x[k-1]/order);
+      runs.add(sma);
+    }
+  }
+
+  runs.finish();
+  feaclip_runs(x, n, sum / n, repr);
+}
+
 //' @rdname clipping
 //' @name clipping
 //' @title Creates bit-level (clipped representation) from a vector
@@ -136,74 +372,9 @@ IntegerVector trending(NumericVector x) {
 // [[Rcpp::export]]
 NumericVector repr_feaclip(NumericVector x) {
 
-  NumericVector y;
-  Rcpp::List encode;
   NumericVector representation(8);
-  int N, j = 0, k = 0;
-
-  y = clipping(x);
-
-  encode = rleC(y);
-
-  IntegerVector lengths = encode["lengths"];
-  IntegerVector values = encode["values"];
-
-  N = values.size();
-
-  representation[3] = N - 1;
-
-  if(values[0] == 0) {
-    representation[4] = lengths[0];
-  } else representation[4] = 0;
-
-  if(values[0] == 1) {
-    representation[6] = lengths[0];
-  } else representation[6] = 0;
-
-  if(values[N-1] == 0) {
-    representation[5] = lengths[N-1];
-  } else representation[5] = 0;
-
-  if(values[N-1] == 1) {
-    representation[7] = lengths[N-1];
-  } else representation[7] = 0;
-
-  for(int i = 0; i < N; ++i) {
-    if(values[i] == 0) {
-      j = j + 1;
-    } else {
-      k = k + 1;
-    }
-  }
-
-  std::vector<int> zeros(j), ones(k);
 
-  j = 0;
-  k = 0;
-
-  for(int i = 0; i < N; ++i) {
-    if(values[i] == 0) {
-      zeros[j] = lengths[i];
-      j = j + 1;
-    } else {
-      ones[k] = lengths[i];
-      k = k + 1;
-    }
-  }
-
-  if(ones.size() == 0) {
-    representation[0] = 0;
-    representation[1] = 0;
-  } else {
-    representation[0] = *std::max_element(ones.begin(), ones.end());
-    representation[1] = std::accumulate(ones.begin(), ones.end(), 0.0);
-  }
-
-  if(zeros.size() == 0) {
-    representation[2] = 0;
-  } else {
-    representation[2] = *std::max_element(zeros.begin(), zeros.end());
-  }
+  feaclip_kernel(x.begin(), x.size(), representation.begin());
 
   StringVector fea_name = StringVector::create("max_1", "sum_1", "max_0", "cross.", "f_0", "l_0", "f_1", "l_1");
   representation.attr("names") = fea_name;
@@ -219,7 +390,8 @@ NumericVector repr_feaclip(NumericVector x) {
 //' @return the numeric vector of the length pieces
 //'
 //' @param x the numeric vector (time series)
-//' @param func the function of aggregation, can be sumC or maxC or similar aggregation function
+//' @param func the function of aggregation, can be sumC or maxC or similar aggregation function,
+//'  the name of the native aggregation or \code{\link{native_aggr}}
 //' @param pieces the number of parts of time series to split (default to 2)
 //' @param order the order of simple moving average (default to 4)
 //'
@@ -228,6 +400,10 @@ NumericVector repr_feaclip(NumericVector x) {
 //' From every piece, 2 features are extracted. You can define what feature will be extracted,
 //' recommended functions are max and sum. For example if max is selected, then maximum value of run lengths of ones and zeros are extracted.
 //'
+//' Aggregations by helper functions (\code{maxC}, \code{sumC}, \code{meanC}, \code{minC} and \code{medianC})
+//' and native aggregations (see \code{\link{native_aggr}}) are computed natively by one pass through the time series,
+//' other functions are called from R for every piece.
+//'
 //' @seealso \code{\link[TSrepr]{repr_feaclip}, \link[TSrepr]{repr_feacliptrend}}
 //'
 //' @author Peter Laurinec, <tsreprpackage@gmail.com>
@@ -242,19 +418,26 @@ NumericVector repr_feaclip(NumericVector x) {
 //' @useDynLib TSrepr
 //' @export repr_featrend
 // [[Rcpp::export]]
-NumericVector repr_featrend(NumericVector x, Rcpp::Function func, int pieces = 2, int order = 4) {
+NumericVector repr_featrend(NumericVector x, SEXP func, int pieces = 2, int order = 4) {
+
+  Aggregation aggr = find_aggr(func);
+
+  if (aggr != NULL) {
+    NumericVector repr(pieces*2);
+    featrend_kernel(x.begin(), x.size(), pieces, order, aggr, repr.begin());
+    return repr;
+  }
 
+  Rcpp::Function r_func(func);
   NumericVector sma_x;
 
   sma_x = repr_sma(x, order);
 
-  NumericVector y;
-  Rcpp::List encode;
+  IntegerVector y;
   NumericVector repr(pieces*2);
-  int n = sma_x.size(), N;
+  int n = sma_x.size();
   int n_piece = n / pieces;
   IntegerVector x_ind(n_piece);
-  int o = 0, z = 0;
 
   for(int j = 0; j < pieces; j++){
     for(int i = 0; i < n_piece; i++){
@@ -263,46 +446,23 @@ NumericVector repr_featrend(NumericVector x, Rcpp::Function func, int pieces = 2
 
     y = trending(sma_x[x_ind]);
 
-    encode = rleC(y);
+    // run lengths of ones and zeros directly from runs of the trending vector
+    std::vector<int> zeros, ones;
 
-    IntegerVector lengths = encode["lengths"];
-    IntegerVector values = encode["values"];
-
-    N = values.size();
-
-    for(int i = 0; i < N; ++i) {
-      if(values[i] == 0) {
-        z = z + 1;
-      } else {
-        o = o + 1;
-      }
-    }
-
-    std::vector<int> zeros(z), ones(o);
-
-    z = 0;
-    o = 0;
-
-    for(int i = 0; i < N; ++i) {
-      if(values[i] == 0) {
-        zeros[z] = lengths[i];
-        z = z + 1;
-      } else {
-        ones[o] = lengths[i];
-        o = o + 1;
-      }
-    }
+    rle_runs(y.begin(), (int) y.size(), [&](int start, int length) {
+      (y[start] == 0 ? zeros : ones).push_back(length);
+    });
 
     if(ones.size() == 0) {
       repr[j*2] = 0;
     } else {
-       repr[j*2] = Rcpp::as<double>(func(ones));
+       repr[j*2] = Rcpp::as<double>(r_func(ones));
     }
 
     if(zeros.size() == 0) {
       repr[j*2 + 1] = 0;
     } else {
-       repr[j*2 +1] = Rcpp::as<double>(func(zeros));
+       repr[j*2 +1] = Rcpp::as<double>(r_func(zeros));
     }
   }
 
@@ -319,12 +479,15 @@ NumericVector repr_featrend(NumericVector x, Rcpp::Function func, int pieces = 2
 //' @return the numeric vector of frequencies of features
 //'
 //' @param x the numeric vector (time series)
-//' @param func the aggregation function for FeaTrend procedure (sumC or maxC)
+//' @param func the aggregation function for FeaTrend procedure (sumC or maxC, or the native aggregation)
 //' @param pieces the number of parts of time series to split
 //' @param order the order of simple moving average
 //'
 //' @details FeaClipTrend combines FeaClip and FeaTrend representation methods.
 //' See documentation of these two methods (check See Also section).
+//' With helper aggregation functions (\code{maxC}, \code{sumC}, \code{meanC}, \code{minC} and \code{medianC}),
+//' both sets of features are computed natively by two sweeps through the time series
+//' (the mean with SMA and trending runs, then clipping runs).
 //'
 //' @seealso \code{\link[TSrepr]{repr_featrend}, \link[TSrepr]{repr_feaclip}}
 //'
@@ -340,7 +503,15 @@ NumericVector repr_featrend(NumericVector x, Rcpp::Function func, int pieces = 2
 //' @useDynLib TSrepr
 //' @export repr_feacliptrend
 // [[Rcpp::export]]
-std::vector<double> repr_feacliptrend(NumericVector x, Rcpp::Function func, int pieces = 2, int order = 4) {
+std::vector<double> repr_feacliptrend(NumericVector x, SEXP func, int pieces = 2, int order = 4) {
+
+  Aggregation aggr = find_aggr(func);
+
+  if (aggr != NULL) {
+    std::vector<double> repr(8 + (pieces * 2));
+    feacliptrend_kernel(x.begin(), x.size(), pieces, order, aggr, repr.data());
+    return repr;
+  }
 
   std::vector<double> repr;
   NumericVector repr_clip(8), repr_trend(pieces * 2);
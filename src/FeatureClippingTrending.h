@@ -0,0 +1,23 @@
+#ifndef TSREPR_FEATURECLIPPINGTRENDING_H
+#define TSREPR_FEATURECLIPPINGTRENDING_H
+
+#include <Rcpp.h>
+#include "helpers.h"
+using namespace Rcpp;
+
+IntegerVector clipping(NumericVector x);
+IntegerVector trending(NumericVector x);
+NumericVector repr_feaclip(NumericVector x);
+NumericVector repr_featrend(NumericVector x, SEXP func, int pieces, int order);
+std::vector<double> repr_feacliptrend(NumericVector x, SEXP func, int pieces, int order);
+
+void feaclip_kernel(const double* x, int n, double* repr);
+// FeaClip features after the given mean of x
+void feaclip_runs(const double* x, int n, double x_mean, double* repr);
+// FeaTrend features (aggregated run lengths of ones and zeros of trending
+// of every piece of SMA of x) by one pass through x, NA if n <= order
+void featrend_kernel(const double* x, int n, int pieces, int order, Aggregation aggr, double* repr);
+// FeaClip features followed by FeaTrend features, NA if n <= order
+void feacliptrend_kernel(const double* x, int n, int pieces, int order, Aggregation aggr, double* repr);
+
+#endif
@@ -0,0 +1,109 @@
+#include <queue>
+#include <vector>
+#include <algorithm>
+#include <Rcpp.h>
+using namespace Rcpp;
+
+// Candidate for the next PIP, the point of a segment between two adjacent
+// PIPs with the maximal distance from the line connecting them
+struct PipCandidate {
+  double dist;
+  int place, left, right;
+
+  // ordering of the priority queue, ties are broken by the first place
+  bool operator<(const PipCandidate& other) const {
+    if (dist != other.dist) {
+      return dist < other.dist;
+    }
+    return place > other.place;
+  }
+};
+
+// Finds the candidate of the segment (left, right), returns false
+// if there is no point between left and right
+static bool segment_candidate(const double* x, int left, int right, bool perpendicular,
+                              PipCandidate& candidate) {
+
+  if (right - left < 2) {
+    return false;
+  }
+
+  double dx = right - left, dy = x[right] - x[left];
+  double norm = sqrt((dx * dx) + (dy * dy));
+
+  // NaN distances (NA values) are never accepted, the first point is
+  // the candidate if there is no valid distance
+  candidate.dist = -1;
+  candidate.place = left + 1;
+  candidate.left = left;
+  candidate.right = right;
+
+  for(int i = left + 1; i < right; i++){
+    double dist;
+    if (perpendicular) {
+      dist = std::fabs((dx * (x[i] - x[left])) - (dy * (i - left))) / norm;
+    } else {
+      // linear interpolation as by approx
+      dist = std::fabs(x[i] - (x[left] + (dy * ((i - left) / dx))));
+    }
+    if (dist > candidate.dist) {
+      candidate.dist = dist;
+      candidate.place = i;
+    }
+  }
+
+  return true;
+}
+
+// Places (1-based, sorted) of times + 1 perceptually important points of x,
+// only the segment split by the new PIP is searched again after each insertion
+// [[Rcpp::export]]
+IntegerVector pip_native(NumericVector x, int times, std::string distance) {
+
+  if (distance != "vertical" && distance != "perpendicular") {
+    Rcpp::stop("distance must be \"vertical\" or \"perpendicular\"!");
+  }
+
+  bool perpendicular = distance == "perpendicular";
+  int n = x.size();
+  const double* values = x.begin();
+
+  for(int i = 0; i < n; i++){
+    if (ISNAN(values[i])) {
+      Rcpp::stop("x must not contain NA values!");
+    }
+  }
+  std::vector<int> pips;
+  std::priority_queue<PipCandidate> queue;
+  PipCandidate candidate;
+
+  pips.push_back(0);
+  pips.push_back(n - 1);
+
+  if (segment_candidate(values, 0, n - 1, perpendicular, candidate)) {
+    queue.push(candidate);
+  }
+
+  for(int i = 1; i < times && !queue.empty(); i++){
+    PipCandidate best = queue.top();
+    queue.pop();
+
+    pips.push_back(best.place);
+
+    if (segment_candidate(values, best.left, best.place, perpendicular, candidate)) {
+      queue.push(candidate);
+    }
+    if (segment_candidate(values, best.place, best.right, perpendicular, candidate)) {
+      queue.push(candidate);
+    }
+  }
+
+  std::sort(pips.begin(), pips.end());
+
+  IntegerVector places(pips.size());
+  for(size_t i = 0; i < pips.size(); i++){
+    places[i] = pips[i] + 1;
+  }
+
+  return places;
+}
@@ -0,0 +1,380 @@
+#include <vector>
+#include <algorithm>
+#include <Rcpp.h>
+using namespace Rcpp;
+
+// Min-heap of keys of nodes 0, ..., n-1 with positions of nodes in the heap,
+// so a key of any node can be changed or removed in O(log n).
+// Ties are broken by the lower node.
+class IndexedHeap {
+public:
+  IndexedHeap(int n) : key(n), pos(n, -1) {
+    heap.reserve(n);
+  }
+
+  bool empty() const {
+    return heap.empty();
+  }
+
+  int top() const {
+    return heap[0];
+  }
+
+  bool contains(int node) const {
+    return pos[node] != -1;
+  }
+
+  void push(int node, double k) {
+    key[node] = k;
+    pos[node] = heap.size();
+    heap.push_back(node);
+    sift_up(pos[node]);
+  }
+
+  void update(int node, double k) {
+    key[node] = k;
+    sift_up(pos[node]);
+    sift_down(pos[node]);
+  }
+
+  void remove(int node) {
+    int i = pos[node];
+    int last = heap.back();
+    heap.pop_back();
+    pos[node] = -1;
+
+    if (last != node) {
+      heap[i] = last;
+      pos[last] = i;
+      sift_up(i);
+      sift_down(pos[last]);
+    }
+  }
+
+private:
+  std::vector<double> key;
+  std::vector<int> heap, pos;
+
+  bool less(int a, int b) const {
+    return key[a] < key[b] || (key[a] == key[b] && a < b);
+  }
+
+  void swap_nodes(int i, int j) {
+    std::swap(heap[i], heap[j]);
+    pos[heap[i]] = i;
+    pos[heap[j]] = j;
+  }
+
+  void sift_up(int i) {
+    while (i > 0 && less(heap[i], heap[(i - 1) / 2])) {
+      swap_nodes(i, (i - 1) / 2);
+      i = (i - 1) / 2;
+    }
+  }
+
+  void sift_down(int i) {
+    int n = heap.size();
+    while (true) {
+      int smallest = i, l = (2 * i) + 1, r = l + 1;
+      if (l < n && less(heap[l], heap[smallest])) smallest = l;
+      if (r < n && less(heap[r], heap[smallest])) smallest = r;
+      if (smallest == i) break;
+      swap_nodes(i, smallest);
+      i = smallest;
+    }
+  }
+};
+
+// Segment of repr_pla, the line a*x + b from startp of the length runlength
+struct PlaSegment {
+  double a, b;
+  int startp, runlength;
+};
+
+// Merged segment with the slope weighted by lengths of segments,
+// starting at the value of the first segment
+static PlaSegment merge_segments(const PlaSegment& s1, const PlaSegment& s2) {
+  PlaSegment merged;
+
+  merged.a = ((s1.a * s1.runlength) + (s2.a * s2.runlength)) / (s1.runlength + s2.runlength);
+  merged.startp = s1.startp;
+  merged.runlength = s1.runlength + s2.runlength;
+
+  if (s1.a == s2.a) {
+    merged.b = s1.b;
+  } else {
+    merged.b = ((s1.a * s1.startp) + s1.b) - (merged.a * s1.startp);
+  }
+
+  return merged;
+}
+
+// Integral of the difference of lines of segments s1 and s2 from x1 to x2
+static double segment_diff(const PlaSegment& s1, const PlaSegment& s2, double x1, double x2) {
+  return ((s1.a - s2.a) * ((x2 * x2) - (x1 * x1)) / 2) + ((s1.b - s2.b) * (x2 - x1));
+}
+
+static double merge_cost(const PlaSegment& s1, const PlaSegment& s2) {
+  PlaSegment merged = merge_segments(s1, s2);
+
+  double cost = segment_diff(merged, s1, s1.startp, s1.startp + s1.runlength) +
+    segment_diff(merged, s2, s2.startp, s2.startp + s2.runlength);
+
+  return std::fabs(cost);
+}
+
+// Bottom-up PLA of repr_pla: segments between consecutive values are merged
+// by the minimal cost until times segments remain. Segments are kept in the
+// doubly linked list and the cost of merging every segment with its right
+// neighbour in the indexed heap. As in the original implementation, only the
+// cost of the merged segment is recomputed after a merge.
+// Returns places and points (values of lines at borders of segments).
+// [[Rcpp::export]]
+NumericMatrix pla_bottom_up_native(NumericVector x, int times) {
+
+  int n_seg = x.size() - 1;
+  std::vector<PlaSegment> segs(n_seg);
+  std::vector<int> prev(n_seg), next(n_seg);
+  IndexedHeap costs(n_seg);
+
+  for(int i = 0; i < n_seg; i++){
+    segs[i].a = x[i+1] - x[i];
+    segs[i].b = x[i] - (segs[i].a * i);
+    segs[i].startp = i;
+    segs[i].runlength = 1;
+    prev[i] = i - 1;
+    next[i] = i + 1 < n_seg ? i + 1 : -1;
+  }
+
+  for(int i = 0; i < n_seg - 1; i++){
+    costs.push(i, merge_cost(segs[i], segs[i+1]));
+  }
+
+  int count = n_seg;
+
+  while (count > times && !costs.empty()) {
+    int i = costs.top(), j = next[i];
+
+    segs[i] = merge_segments(segs[i], segs[j]);
+
+    // unlink j
+    next[i] = next[j];
+    if (next[j] != -1) {
+      prev[next[j]] = i;
+    }
+    if (costs.contains(j)) {
+      costs.remove(j);
+    }
+    count--;
+
+    if (next[i] != -1) {
+      costs.update(i, merge_cost(segs[i], segs[next[i]]));
+    } else {
+      costs.remove(i);
+    }
+  }
+
+  NumericMatrix repr(count + 1, 2);
+  int x_pos = 0, k = 1;
+
+  repr(0, 0) = 0;
+  repr(0, 1) = segs[0].b;
+
+  for(int i = 0; i != -1; i = next[i]){
+    x_pos += segs[i].runlength;
+    repr(k, 0) = x_pos;
+    repr(k, 1) = (segs[i].a * x_pos) + segs[i].b;
+    k++;
+  }
+
+  return repr;
+}
+
+// Prefix sums of values of x (with places relative to from) for
+// O(1) errors of linear interpolations of x between any two places
+class InterpolationError {
+public:
+  InterpolationError(const double* x, int from, int to) : x(x), from(from) {
+    int n = to - from + 1;
+    sum_y.assign(n + 1, 0);
+    sum_yy.assign(n + 1, 0);
+    sum_ty.assign(n + 1, 0);
+
+    for(int i = 0; i < n; i++){
+      double y = x[from + i];
+      sum_y[i+1] = sum_y[i] + y;
+      sum_yy[i+1] = sum_yy[i] + (y * y);
+      sum_ty[i+1] = sum_ty[i] + (i * y);
+    }
+  }
+
+  // sum of squared residuals of values from a to b to the line connecting x[a] and x[b]
+  double error(int a, int b) const {
+    if (b - a < 2) {
+      return 0;
+    }
+
+    int ra = a - from, rb = b - from;
+    double d = b - a, m = d + 1;
+    double ya = x[a], slope = (x[b] - ya) / d;
+    double sy = sum_y[rb+1] - sum_y[ra];
+    double syy = sum_yy[rb+1] - sum_yy[ra];
+    double suy = (sum_ty[rb+1] - sum_ty[ra]) - (ra * sy);
+    double su = d * m / 2, suu = d * m * ((2 * d) + 1) / 6;
+
+    double szz = syy - (2 * ya * sy) + (m * ya * ya);
+    double szu = suy - (ya * su);
+    double sse = szz - (2 * slope * szu) + (slope * slope * suu);
+
+    return std::max(sse, 0.0);
+  }
+
+private:
+  const double* x;
+  int from;
+  std::vector<double> sum_y, sum_yy, sum_ty;
+};
+
+// Bottom-up segmentation of x[from..to] by linear interpolation, segments are
+// merged while the error of the merged segment is at most max_error.
+// Returns breakpoints (places shared by adjacent segments) including from and to.
+static std::vector<int> bottom_up_interpolation(const double* x, int from, int to, double max_error) {
+
+  InterpolationError err(x, from, to);
+  int n = to - from + 1;
+  std::vector<int> next(n), prev(n);
+  IndexedHeap costs(n);
+
+  // node i is the breakpoint from + i, its cost is the cost of its removal
+  for(int i = 0; i < n; i++){
+    prev[i] = i - 1;
+    next[i] = i + 1 < n ? i + 1 : -1;
+  }
+  for(int i = 1; i < n - 1; i++){
+    costs.push(i, err.error(from + i - 1, from + i + 1));
+  }
+
+  while (!costs.empty()) {
+    int i = costs.top();
+    int p = prev[i], q = next[i];
+
+    if (err.error(from + p, from + q) > max_error) {
+      break;
+    }
+
+    costs.remove(i);
+    next[p] = q;
+    prev[q] = p;
+
+    if (prev[p] != -1) {
+      costs.update(p, err.error(from + prev[p], from + q));
+    }
+    if (next[q] != -1) {
+      costs.update(q, err.error(from + p, from + next[q]));
+    }
+  }
+
+  std::vector<int> breakpoints;
+  for(int i = 0; i != -1; i = next[i]){
+    breakpoints.push_back(from + i);
+  }
+
+  return breakpoints;
+}
+
+// The end of the longest segment from anchor with the error at most max_error,
+// running sums are relative to anchor, so every added value costs O(1)
+static int sliding_window_end(const double* x, int n, int anchor, double max_error) {
+
+  double ya = x[anchor], sy = ya, syy = ya * ya, suy = 0;
+  int b = anchor + 1;
+
+  if (b >= n - 1) {
+    return n - 1;
+  }
+
+  sy += x[b];
+  syy += x[b] * x[b];
+  suy += (b - anchor) * x[b];
+
+  while (b + 1 < n) {
+    int c = b + 1;
+    double yc = x[c];
+    double d = c - anchor, m = d + 1;
+    double sy_c = sy + yc, syy_c = syy + (yc * yc), suy_c = suy + (d * yc);
+    double slope = (yc - ya) / d;
+    double su = d * m / 2, suu = d * m * ((2 * d) + 1) / 6;
+    double szz = syy_c - (2 * ya * sy_c) + (m * ya * ya);
+    double szu = suy_c - (ya * su);
+    double sse = szz - (2 * slope * szu) + (slope * slope * suu);
+
+    if (sse > max_error) {
+      break;
+    }
+
+    sy = sy_c;
+    syy = syy_c;
+    suy = suy_c;
+    b = c;
+  }
+
+  return b;
+}
+
+// Breakpoints (1-based places) of online PLA segmentation of x by linear
+// interpolation, by the sliding window or by SWAB (sliding window and bottom-up)
+// [[Rcpp::export]]
+IntegerVector pla_online_native(NumericVector x, double max_error, std::string method, int buffer_size) {
+
+  if (method != "sliding_window" && method != "swab") {
+    Rcpp::stop("method must be \"sliding_window\" or \"swab\"!");
+  }
+  if (max_error < 0) {
+    Rcpp::stop("max_error must be non-negative!");
+  }
+  if (buffer_size < 3) {
+    Rcpp::stop("buffer_size must be at least 3!");
+  }
+
+  int n = x.size();
+  const double* values = x.begin();
+  std::vector<int> breakpoints(1, 0);
+
+  if (method == "sliding_window") {
+
+    for (int anchor = 0; anchor < n - 1;) {
+      anchor = sliding_window_end(values, n, anchor, max_error);
+      breakpoints.push_back(anchor);
+    }
+
+  } else {
+
+    // the buffer is x[from..to], its first segment is emitted and
+    // the buffer is extended by the next segment of the sliding window,
+    // the buffer approximated by one segment is only extended
+    int from = 0, to = std::min(buffer_size, n) - 1;
+
+    while (to < n - 1) {
+      std::vector<int> buffer_points = bottom_up_interpolation(values, from, to, max_error);
+
+      if (buffer_points.size() > 2) {
+        from = buffer_points[1];
+        breakpoints.push_back(from);
+      }
+
+      do {
+        to = sliding_window_end(values, n, to, max_error);
+      } while (to < n - 1 && to - from + 1 < buffer_size);
+    }
+
+    std::vector<int> buffer_points = bottom_up_interpolation(values, from, to, max_error);
+    breakpoints.insert(breakpoints.end(), buffer_points.begin() + 1, buffer_points.end());
+  }
+
+  IntegerVector places(breakpoints.size());
+  for(size_t i = 0; i < breakpoints.size(); i++){
+    places[i] = breakpoints[i] + 1;
+  }
+
+  return places;
+}
@@ -5,6 +5,33 @@
 
 using namespace Rcpp;
 
+// fourier_native
+NumericVector fourier_native(NumericVector x, int coef, std::string type, bool coefficients);
+RcppExport SEXP _TSrepr_fourier_native(SEXP xSEXP, SEXP coefSEXP, SEXP typeSEXP, SEXP coefficientsSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< NumericVector >::type x(xSEXP);
+    Rcpp::traits::input_parameter< int >::type coef(coefSEXP);
+    Rcpp::traits::input_parameter< std::string >::type type(typeSEXP);
+    Rcpp::traits::input_parameter< bool >::type coefficients(coefficientsSEXP);
+    rcpp_result_gen = Rcpp::wrap(fourier_native(x, coef, type, coefficients));
+    return rcpp_result_gen;
+END_RCPP
+}
+// dwt_native
+NumericVector dwt_native(NumericVector x, int level, SEXP filter);
+RcppExport SEXP _TSrepr_dwt_native(SEXP xSEXP, SEXP levelSEXP, SEXP filterSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< NumericVector >::type x(xSEXP);
+    Rcpp::traits::input_parameter< int >::type level(levelSEXP);
+    Rcpp::traits::input_parameter< SEXP >::type filter(filterSEXP);
+    rcpp_result_gen = Rcpp::wrap(dwt_native(x, level, filter));
+    return rcpp_result_gen;
+END_RCPP
+}
 // clipping
 IntegerVector clipping(NumericVector x);
 RcppExport SEXP _TSrepr_clipping(SEXP xSEXP) {
@@ -39,13 +66,13 @@ BEGIN_RCPP
 END_RCPP
 }
 // repr_featrend
-NumericVector repr_featrend(NumericVector x, Rcpp::Function func, int pieces, int order);
+NumericVector repr_featrend(NumericVector x, SEXP func, int pieces, int order);
 RcppExport SEXP _TSrepr_repr_featrend(SEXP xSEXP, SEXP funcSEXP, SEXP piecesSEXP, SEXP orderSEXP) {
 BEGIN_RCPP
     Rcpp::RObject rcpp_result_gen;
     Rcpp::RNGScope rcpp_rngScope_gen;
     Rcpp::traits::input_parameter< NumericVector >::type x(xSEXP);
-    Rcpp::traits::input_parameter< Rcpp::Function >::type func(funcSEXP);
+    Rcpp::traits::input_parameter< SEXP >::type func(funcSEXP);
     Rcpp::traits::input_parameter< int >::type pieces(piecesSEXP);
     Rcpp::traits::input_parameter< int >::type order(orderSEXP);
     rcpp_result_gen = Rcpp::wrap(repr_featrend(x, func, pieces, order));
@@ -53,19 +80,224 @@ BEGIN_RCPP
 END_RCPP
 }
 // repr_feacliptrend
-std::vector<double> repr_feacliptrend(NumericVector x, Rcpp::Function func, int pieces, int order);
+std::vector<double> repr_feacliptrend(NumericVector x, SEXP func, int pieces, int order);
 RcppExport SEXP _TSrepr_repr_feacliptrend(SEXP xSEXP, SEXP funcSEXP, SEXP piecesSEXP, SEXP orderSEXP) {
 BEGIN_RCPP
     Rcpp::RObject rcpp_result_gen;
     Rcpp::RNGScope rcpp_rngScope_gen;
     Rcpp::traits::input_parameter< NumericVector >::type x(xSEXP);
-    Rcpp::traits::input_parameter< Rcpp::Function >::type func(funcSEXP);
+    Rcpp::traits::input_parameter< SEXP >::type func(funcSEXP);
     Rcpp::traits::input_parameter< int >::type pieces(piecesSEXP);
     Rcpp::traits::input_parameter< int >::type order(orderSEXP);
     rcpp_result_gen = Rcpp::wrap(repr_feacliptrend(x, func, pieces, order));
     return rcpp_result_gen;
 END_RCPP
 }
+// pip_native
+IntegerVector pip_native(NumericVector x, int times, std::string distance);
+RcppExport SEXP _TSrepr_pip_native(SEXP xSEXP, SEXP timesSEXP, SEXP distanceSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< NumericVector >::type x(xSEXP);
+    Rcpp::traits::input_parameter< int >::type times(timesSEXP);
+    Rcpp::traits::input_parameter< std::string >::type distance(distanceSEXP);
+    rcpp_result_gen = Rcpp::wrap(pip_native(x, times, distance));
+    return rcpp_result_gen;
+END_RCPP
+}
+// pla_bottom_up_native
+NumericMatrix pla_bottom_up_native(NumericVector x, int times);
+RcppExport SEXP _TSrepr_pla_bottom_up_native(SEXP xSEXP, SEXP timesSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< NumericVector >::type x(xSEXP);
+    Rcpp::traits::input_parameter< int >::type times(timesSEXP);
+    rcpp_result_gen = Rcpp::wrap(pla_bottom_up_native(x, times));
+    return rcpp_result_gen;
+END_RCPP
+}
+// pla_online_native
+IntegerVector pla_online_native(NumericVector x, double max_error, std::string method, int buffer_size);
+RcppExport SEXP _TSrepr_pla_online_native(SEXP xSEXP, SEXP max_errorSEXP, SEXP methodSEXP, SEXP buffer_sizeSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< NumericVector >::type x(xSEXP);
+    Rcpp::traits::input_parameter< double >::type max_error(max_errorSEXP);
+    Rcpp::traits::input_parameter< std::string >::type method(methodSEXP);
+    Rcpp::traits::input_parameter< int >::type buffer_size(buffer_sizeSEXP);
+    rcpp_result_gen = Rcpp::wrap(pla_online_native(x, max_error, method, buffer_size));
+    return rcpp_result_gen;
+END_RCPP
+}
+// sax_native
+SEXP sax_native(NumericVector x, int q, int a, double eps, bool normalise, std::string type);
+RcppExport SEXP _TSrepr_sax_native(SEXP xSEXP, SEXP qSEXP, SEXP aSEXP, SEXP epsSEXP, SEXP normaliseSEXP, SEXP typeSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< NumericVector >::type x(xSEXP);
+    Rcpp::traits::input_parameter< int >::type q(qSEXP);
+    Rcpp::traits::input_parameter< int >::type a(aSEXP);
+    Rcpp::traits::input_parameter< double >::type eps(epsSEXP);
+    Rcpp::traits::input_parameter< bool >::type normalise(normaliseSEXP);
+    Rcpp::traits::input_parameter< std::string >::type type(typeSEXP);
+    rcpp_result_gen = Rcpp::wrap(sax_native(x, q, a, eps, normalise, type));
+    return rcpp_result_gen;
+END_RCPP
+}
+// unpack_sax
+IntegerVector unpack_sax(RawVector x);
+RcppExport SEXP _TSrepr_unpack_sax(SEXP xSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< RawVector >::type x(xSEXP);
+    rcpp_result_gen = Rcpp::wrap(unpack_sax(x));
+    return rcpp_result_gen;
+END_RCPP
+}
+// sax_mindist_native
+double sax_mindist_native(IntegerVector x, IntegerVector y, int n, int a);
+RcppExport SEXP _TSrepr_sax_mindist_native(SEXP xSEXP, SEXP ySEXP, SEXP nSEXP, SEXP aSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< IntegerVector >::type x(xSEXP);
+    Rcpp::traits::input_parameter< IntegerVector >::type y(ySEXP);
+    Rcpp::traits::input_parameter< int >::type n(nSEXP);
+    Rcpp::traits::input_parameter< int >::type a(aSEXP);
+    rcpp_result_gen = Rcpp::wrap(sax_mindist_native(x, y, n, a));
+    return rcpp_result_gen;
+END_RCPP
+}
+// clipping_packed
+RawVector clipping_packed(NumericVector x);
+RcppExport SEXP _TSrepr_clipping_packed(SEXP xSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< NumericVector >::type x(xSEXP);
+    rcpp_result_gen = Rcpp::wrap(clipping_packed(x));
+    return rcpp_result_gen;
+END_RCPP
+}
+// trending_packed
+RawVector trending_packed(NumericVector x);
+RcppExport SEXP _TSrepr_trending_packed(SEXP xSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< NumericVector >::type x(xSEXP);
+    rcpp_result_gen = Rcpp::wrap(trending_packed(x));
+    return rcpp_result_gen;
+END_RCPP
+}
+// unpack_bits
+IntegerVector unpack_bits(RawVector x);
+RcppExport SEXP _TSrepr_unpack_bits(SEXP xSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< RawVector >::type x(xSEXP);
+    rcpp_result_gen = Rcpp::wrap(unpack_bits(x));
+    return rcpp_result_gen;
+END_RCPP
+}
+// rle_packed
+List rle_packed(RawVector x);
+RcppExport SEXP _TSrepr_rle_packed(SEXP xSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< RawVector >::type x(xSEXP);
+    rcpp_result_gen = Rcpp::wrap(rle_packed(x));
+    return rcpp_result_gen;
+END_RCPP
+}
+// feaclip_packed
+NumericVector feaclip_packed(RawVector x);
+RcppExport SEXP _TSrepr_feaclip_packed(SEXP xSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< RawVector >::type x(xSEXP);
+    rcpp_result_gen = Rcpp::wrap(feaclip_packed(x));
+    return rcpp_result_gen;
+END_RCPP
+}
+// hamming_packed
+int hamming_packed(RawVector x, RawVector y);
+RcppExport SEXP _TSrepr_hamming_packed(SEXP xSEXP, SEXP ySEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< RawVector >::type x(xSEXP);
+    Rcpp::traits::input_parameter< RawVector >::type y(ySEXP);
+    rcpp_result_gen = Rcpp::wrap(hamming_packed(x, y));
+    return rcpp_result_gen;
+END_RCPP
+}
+// lb_clipped
+double lb_clipped(NumericVector q, RawVector x);
+RcppExport SEXP _TSrepr_lb_clipped(SEXP qSEXP, SEXP xSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< NumericVector >::type q(qSEXP);
+    Rcpp::traits::input_parameter< RawVector >::type x(xSEXP);
+    rcpp_result_gen = Rcpp::wrap(lb_clipped(q, x));
+    return rcpp_result_gen;
+END_RCPP
+}
+// repr_exp_native
+NumericVector repr_exp_native(NumericVector x, int freq, double alpha, double gamma);
+RcppExport SEXP _TSrepr_repr_exp_native(SEXP xSEXP, SEXP freqSEXP, SEXP alphaSEXP, SEXP gammaSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< NumericVector >::type x(xSEXP);
+    Rcpp::traits::input_parameter< int >::type freq(freqSEXP);
+    Rcpp::traits::input_parameter< double >::type alpha(alphaSEXP);
+    Rcpp::traits::input_parameter< double >::type gamma(gammaSEXP);
+    rcpp_result_gen = Rcpp::wrap(repr_exp_native(x, freq, alpha, gamma));
+    return rcpp_result_gen;
+END_RCPP
+}
+// check_native_aggr
+bool check_native_aggr(SEXP aggr);
+RcppExport SEXP _TSrepr_check_native_aggr(SEXP aggrSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< SEXP >::type aggr(aggrSEXP);
+    rcpp_result_gen = Rcpp::wrap(check_native_aggr(aggr));
+    return rcpp_result_gen;
+END_RCPP
+}
+// register_aggr_native
+void register_aggr_native(std::string name, SEXP kernel);
+RcppExport SEXP _TSrepr_register_aggr_native(SEXP nameSEXP, SEXP kernelSEXP) {
+BEGIN_RCPP
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< std::string >::type name(nameSEXP);
+    Rcpp::traits::input_parameter< SEXP >::type kernel(kernelSEXP);
+    register_aggr_native(name, kernel);
+    return R_NilValue;
+END_RCPP
+}
+// aggr_names_native
+CharacterVector aggr_names_native();
+RcppExport SEXP _TSrepr_aggr_names_native() {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    rcpp_result_gen = Rcpp::wrap(aggr_names_native());
+    return rcpp_result_gen;
+END_RCPP
+}
 // maxC
 double maxC(NumericVector x);
 RcppExport SEXP _TSrepr_maxC(SEXP xSEXP) {
@@ -121,6 +353,85 @@ BEGIN_RCPP
     return rcpp_result_gen;
 END_RCPP
 }
+// isax_index
+SEXP isax_index(NumericMatrix x, int q, int a, int leaf_size, bool normalise);
+RcppExport SEXP _TSrepr_isax_index(SEXP xSEXP, SEXP qSEXP, SEXP aSEXP, SEXP leaf_sizeSEXP, SEXP normaliseSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< NumericMatrix >::type x(xSEXP);
+    Rcpp::traits::input_parameter< int >::type q(qSEXP);
+    Rcpp::traits::input_parameter< int >::type a(aSEXP);
+    Rcpp::traits::input_parameter< int >::type leaf_size(leaf_sizeSEXP);
+    Rcpp::traits::input_parameter< bool >::type normalise(normaliseSEXP);
+    rcpp_result_gen = Rcpp::wrap(isax_index(x, q, a, leaf_size, normalise));
+    return rcpp_result_gen;
+END_RCPP
+}
+// isax_knn
+List isax_knn(SEXP index, NumericVector query, int k, bool exact);
+RcppExport SEXP _TSrepr_isax_knn(SEXP indexSEXP, SEXP querySEXP, SEXP kSEXP, SEXP exactSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< SEXP >::type index(indexSEXP);
+    Rcpp::traits::input_parameter< NumericVector >::type query(querySEXP);
+    Rcpp::traits::input_parameter< int >::type k(kSEXP);
+    Rcpp::traits::input_parameter< bool >::type exact(exactSEXP);
+    rcpp_result_gen = Rcpp::wrap(isax_knn(index, query, k, exact));
+    return rcpp_result_gen;
+END_RCPP
+}
+// repr_lm_native
+NumericVector repr_lm_native(NumericVector x, IntegerVector freq, std::string method);
+RcppExport SEXP _TSrepr_repr_lm_native(SEXP xSEXP, SEXP freqSEXP, SEXP methodSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< NumericVector >::type x(xSEXP);
+    Rcpp::traits::input_parameter< IntegerVector >::type freq(freqSEXP);
+    Rcpp::traits::input_parameter< std::string >::type method(methodSEXP);
+    rcpp_result_gen = Rcpp::wrap(repr_lm_native(x, freq, method));
+    return rcpp_result_gen;
+END_RCPP
+}
+// lm_cholesky
+NumericMatrix lm_cholesky(NumericMatrix X);
+RcppExport SEXP _TSrepr_lm_cholesky(SEXP XSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< NumericMatrix >::type X(XSEXP);
+    rcpp_result_gen = Rcpp::wrap(lm_cholesky(X));
+    return rcpp_result_gen;
+END_RCPP
+}
+// lm_solve_cholesky
+NumericMatrix lm_solve_cholesky(NumericMatrix X, NumericMatrix U, NumericMatrix Y);
+RcppExport SEXP _TSrepr_lm_solve_cholesky(SEXP XSEXP, SEXP USEXP, SEXP YSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< NumericMatrix >::type X(XSEXP);
+    Rcpp::traits::input_parameter< NumericMatrix >::type U(USEXP);
+    Rcpp::traits::input_parameter< NumericMatrix >::type Y(YSEXP);
+    rcpp_result_gen = Rcpp::wrap(lm_solve_cholesky(X, U, Y));
+    return rcpp_result_gen;
+END_RCPP
+}
+// lm_robust_matrix
+NumericMatrix lm_robust_matrix(NumericMatrix X, NumericMatrix Y, std::string method);
+RcppExport SEXP _TSrepr_lm_robust_matrix(SEXP XSEXP, SEXP YSEXP, SEXP methodSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< NumericMatrix >::type X(XSEXP);
+    Rcpp::traits::input_parameter< NumericMatrix >::type Y(YSEXP);
+    Rcpp::traits::input_parameter< std::string >::type method(methodSEXP);
+    rcpp_result_gen = Rcpp::wrap(lm_robust_matrix(X, Y, method));
+    return rcpp_result_gen;
+END_RCPP
+}
 // mse
 double mse(NumericVector x, NumericVector y);
 RcppExport SEXP _TSrepr_mse(SEXP xSEXP, SEXP ySEXP) {
@@ -288,6 +599,243 @@ BEGIN_RCPP
     return rcpp_result_gen;
 END_RCPP
 }
+// norm_z_matrix
+List norm_z_matrix(NumericMatrix x);
+RcppExport SEXP _TSrepr_norm_z_matrix(SEXP xSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< NumericMatrix >::type x(xSEXP);
+    rcpp_result_gen = Rcpp::wrap(norm_z_matrix(x));
+    return rcpp_result_gen;
+END_RCPP
+}
+// norm_min_max_matrix
+List norm_min_max_matrix(NumericMatrix x);
+RcppExport SEXP _TSrepr_norm_min_max_matrix(SEXP xSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< NumericMatrix >::type x(xSEXP);
+    rcpp_result_gen = Rcpp::wrap(norm_min_max_matrix(x));
+    return rcpp_result_gen;
+END_RCPP
+}
+// denorm_z_matrix
+NumericMatrix denorm_z_matrix(NumericMatrix x, NumericVector mean, NumericVector sd);
+RcppExport SEXP _TSrepr_denorm_z_matrix(SEXP xSEXP, SEXP meanSEXP, SEXP sdSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< NumericMatrix >::type x(xSEXP);
+    Rcpp::traits::input_parameter< NumericVector >::type mean(meanSEXP);
+    Rcpp::traits::input_parameter< NumericVector >::type sd(sdSEXP);
+    rcpp_result_gen = Rcpp::wrap(denorm_z_matrix(x, mean, sd));
+    return rcpp_result_gen;
+END_RCPP
+}
+// denorm_min_max_matrix
+NumericMatrix denorm_min_max_matrix(NumericMatrix x, NumericVector min, NumericVector max);
+RcppExport SEXP _TSrepr_denorm_min_max_matrix(SEXP xSEXP, SEXP minSEXP, SEXP maxSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< NumericMatrix >::type x(xSEXP);
+    Rcpp::traits::input_parameter< NumericVector >::type min(minSEXP);
+    Rcpp::traits::input_parameter< NumericVector >::type max(maxSEXP);
+    rcpp_result_gen = Rcpp::wrap(denorm_min_max_matrix(x, min, max));
+    return rcpp_result_gen;
+END_RCPP
+}
+// norm_median_mad
+NumericVector norm_median_mad(NumericVector x);
+RcppExport SEXP _TSrepr_norm_median_mad(SEXP xSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< NumericVector >::type x(xSEXP);
+    rcpp_result_gen = Rcpp::wrap(norm_median_mad(x));
+    return rcpp_result_gen;
+END_RCPP
+}
+// norm_median_mad_list
+List norm_median_mad_list(NumericVector x);
+RcppExport SEXP _TSrepr_norm_median_mad_list(SEXP xSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< NumericVector >::type x(xSEXP);
+    rcpp_result_gen = Rcpp::wrap(norm_median_mad_list(x));
+    return rcpp_result_gen;
+END_RCPP
+}
+// denorm_median_mad
+NumericVector denorm_median_mad(NumericVector x, double median, double mad);
+RcppExport SEXP _TSrepr_denorm_median_mad(SEXP xSEXP, SEXP medianSEXP, SEXP madSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< NumericVector >::type x(xSEXP);
+    Rcpp::traits::input_parameter< double >::type median(medianSEXP);
+    Rcpp::traits::input_parameter< double >::type mad(madSEXP);
+    rcpp_result_gen = Rcpp::wrap(denorm_median_mad(x, median, mad));
+    return rcpp_result_gen;
+END_RCPP
+}
+// norm_iqr
+NumericVector norm_iqr(NumericVector x);
+RcppExport SEXP _TSrepr_norm_iqr(SEXP xSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< NumericVector >::type x(xSEXP);
+    rcpp_result_gen = Rcpp::wrap(norm_iqr(x));
+    return rcpp_result_gen;
+END_RCPP
+}
+// norm_iqr_list
+List norm_iqr_list(NumericVector x);
+RcppExport SEXP _TSrepr_norm_iqr_list(SEXP xSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< NumericVector >::type x(xSEXP);
+    rcpp_result_gen = Rcpp::wrap(norm_iqr_list(x));
+    return rcpp_result_gen;
+END_RCPP
+}
+// denorm_iqr
+NumericVector denorm_iqr(NumericVector x, double median, double iqr);
+RcppExport SEXP _TSrepr_denorm_iqr(SEXP xSEXP, SEXP medianSEXP, SEXP iqrSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< NumericVector >::type x(xSEXP);
+    Rcpp::traits::input_parameter< double >::type median(medianSEXP);
+    Rcpp::traits::input_parameter< double >::type iqr(iqrSEXP);
+    rcpp_result_gen = Rcpp::wrap(denorm_iqr(x, median, iqr));
+    return rcpp_result_gen;
+END_RCPP
+}
+// norm_z_rolling
+NumericVector norm_z_rolling(NumericVector x, int win_size, std::string center);
+RcppExport SEXP _TSrepr_norm_z_rolling(SEXP xSEXP, SEXP win_sizeSEXP, SEXP centerSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< NumericVector >::type x(xSEXP);
+    Rcpp::traits::input_parameter< int >::type win_size(win_sizeSEXP);
+    Rcpp::traits::input_parameter< std::string >::type center(centerSEXP);
+    rcpp_result_gen = Rcpp::wrap(norm_z_rolling(x, win_size, center));
+    return rcpp_result_gen;
+END_RCPP
+}
+// repr_matrix_native
+NumericMatrix repr_matrix_native(NumericMatrix x, std::string method, List args, std::string norm, int threads, int win_size);
+RcppExport SEXP _TSrepr_repr_matrix_native(SEXP xSEXP, SEXP methodSEXP, SEXP argsSEXP, SEXP normSEXP, SEXP threadsSEXP, SEXP win_sizeSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< NumericMatrix >::type x(xSEXP);
+    Rcpp::traits::input_parameter< std::string >::type method(methodSEXP);
+    Rcpp::traits::input_parameter< List >::type args(argsSEXP);
+    Rcpp::traits::input_parameter< std::string >::type norm(normSEXP);
+    Rcpp::traits::input_parameter< int >::type threads(threadsSEXP);
+    Rcpp::traits::input_parameter< int >::type win_size(win_sizeSEXP);
+    rcpp_result_gen = Rcpp::wrap(repr_matrix_native(x, method, args, norm, threads, win_size));
+    return rcpp_result_gen;
+END_RCPP
+}
+// repr_windowing_native
+NumericMatrix repr_windowing_native(NumericVector x, std::string method, List args, int win_size, int stride, int threads);
+RcppExport SEXP _TSrepr_repr_windowing_native(SEXP xSEXP, SEXP methodSEXP, SEXP argsSEXP, SEXP win_sizeSEXP, SEXP strideSEXP, SEXP threadsSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< NumericVector >::type x(xSEXP);
+    Rcpp::traits::input_parameter< std::string >::type method(methodSEXP);
+    Rcpp::traits::input_parameter< List >::type args(argsSEXP);
+    Rcpp::traits::input_parameter< int >::type win_size(win_sizeSEXP);
+    Rcpp::traits::input_parameter< int >::type stride(strideSEXP);
+    Rcpp::traits::input_parameter< int >::type threads(threadsSEXP);
+    rcpp_result_gen = Rcpp::wrap(repr_windowing_native(x, method, args, win_size, stride, threads));
+    return rcpp_result_gen;
+END_RCPP
+}
+// repr_stream_native
+SEXP repr_stream_native(std::string method, int win_size, int max_history, List args);
+RcppExport SEXP _TSrepr_repr_stream_native(SEXP methodSEXP, SEXP win_sizeSEXP, SEXP max_historySEXP, SEXP argsSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< std::string >::type method(methodSEXP);
+    Rcpp::traits::input_parameter< int >::type win_size(win_sizeSEXP);
+    Rcpp::traits::input_parameter< int >::type max_history(max_historySEXP);
+    Rcpp::traits::input_parameter< List >::type args(argsSEXP);
+    rcpp_result_gen = Rcpp::wrap(repr_stream_native(method, win_size, max_history, args));
+    return rcpp_result_gen;
+END_RCPP
+}
+// repr_stream_update
+NumericMatrix repr_stream_update(SEXP stream, NumericVector x);
+RcppExport SEXP _TSrepr_repr_stream_update(SEXP streamSEXP, SEXP xSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< SEXP >::type stream(streamSEXP);
+    Rcpp::traits::input_parameter< NumericVector >::type x(xSEXP);
+    rcpp_result_gen = Rcpp::wrap(repr_stream_update(stream, x));
+    return rcpp_result_gen;
+END_RCPP
+}
+// repr_stream_snapshot
+NumericVector repr_stream_snapshot(SEXP stream);
+RcppExport SEXP _TSrepr_repr_stream_snapshot(SEXP streamSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< SEXP >::type stream(streamSEXP);
+    rcpp_result_gen = Rcpp::wrap(repr_stream_snapshot(stream));
+    return rcpp_result_gen;
+END_RCPP
+}
+// dft_stream_native
+SEXP dft_stream_native(int win_size, int coef, bool coefficients, int recompute);
+RcppExport SEXP _TSrepr_dft_stream_native(SEXP win_sizeSEXP, SEXP coefSEXP, SEXP coefficientsSEXP, SEXP recomputeSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< int >::type win_size(win_sizeSEXP);
+    Rcpp::traits::input_parameter< int >::type coef(coefSEXP);
+    Rcpp::traits::input_parameter< bool >::type coefficients(coefficientsSEXP);
+    Rcpp::traits::input_parameter< int >::type recompute(recomputeSEXP);
+    rcpp_result_gen = Rcpp::wrap(dft_stream_native(win_size, coef, coefficients, recompute));
+    return rcpp_result_gen;
+END_RCPP
+}
+// dft_stream_update
+NumericMatrix dft_stream_update(SEXP stream, NumericVector x);
+RcppExport SEXP _TSrepr_dft_stream_update(SEXP streamSEXP, SEXP xSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< SEXP >::type stream(streamSEXP);
+    Rcpp::traits::input_parameter< NumericVector >::type x(xSEXP);
+    rcpp_result_gen = Rcpp::wrap(dft_stream_update(stream, x));
+    return rcpp_result_gen;
+END_RCPP
+}
+// dft_stream_snapshot
+NumericVector dft_stream_snapshot(SEXP stream);
+RcppExport SEXP _TSrepr_dft_stream_snapshot(SEXP streamSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< SEXP >::type stream(streamSEXP);
+    rcpp_result_gen = Rcpp::wrap(dft_stream_snapshot(stream));
+    return rcpp_result_gen;
+END_RCPP
+}
 // repr_sma
 NumericVector repr_sma(NumericVector x, int order);
 RcppExport SEXP _TSrepr_repr_sma(SEXP xSEXP, SEXP orderSEXP) {
@@ -301,54 +849,101 @@ BEGIN_RCPP
 END_RCPP
 }
 // repr_paa
-NumericVector repr_paa(NumericVector x, int q, Rcpp::Function func);
+NumericVector repr_paa(NumericVector x, int q, SEXP func);
 RcppExport SEXP _TSrepr_repr_paa(SEXP xSEXP, SEXP qSEXP, SEXP funcSEXP) {
 BEGIN_RCPP
     Rcpp::RObject rcpp_result_gen;
     Rcpp::RNGScope rcpp_rngScope_gen;
     Rcpp::traits::input_parameter< NumericVector >::type x(xSEXP);
     Rcpp::traits::input_parameter< int >::type q(qSEXP);
-    Rcpp::traits::input_parameter< Rcpp::Function >::type func(funcSEXP);
+    Rcpp::traits::input_parameter< SEXP >::type func(funcSEXP);
     rcpp_result_gen = Rcpp::wrap(repr_paa(x, q, func));
     return rcpp_result_gen;
 END_RCPP
 }
 // repr_seas_profile
-NumericVector repr_seas_profile(NumericVector x, int freq, Rcpp::Function func);
+NumericVector repr_seas_profile(NumericVector x, int freq, SEXP func);
 RcppExport SEXP _TSrepr_repr_seas_profile(SEXP xSEXP, SEXP freqSEXP, SEXP funcSEXP) {
 BEGIN_RCPP
     Rcpp::RObject rcpp_result_gen;
     Rcpp::RNGScope rcpp_rngScope_gen;
     Rcpp::traits::input_parameter< NumericVector >::type x(xSEXP);
     Rcpp::traits::input_parameter< int >::type freq(freqSEXP);
-    Rcpp::traits::input_parameter< Rcpp::Function >::type func(funcSEXP);
+    Rcpp::traits::input_parameter< SEXP >::type func(funcSEXP);
     rcpp_result_gen = Rcpp::wrap(repr_seas_profile(x, freq, func));
     return rcpp_result_gen;
 END_RCPP
 }
 // rleC
-List rleC(NumericVector x);
+List rleC(SEXP x);
 RcppExport SEXP _TSrepr_rleC(SEXP xSEXP) {
 BEGIN_RCPP
     Rcpp::RObject rcpp_result_gen;
     Rcpp::RNGScope rcpp_rngScope_gen;
-    Rcpp::traits::input_parameter< NumericVector >::type x(xSEXP);
+    Rcpp::traits::input_parameter< SEXP >::type x(xSEXP);
     rcpp_result_gen = Rcpp::wrap(rleC(x));
     return rcpp_result_gen;
 END_RCPP
 }
+// rle_decode
+SEXP rle_decode(List x);
+RcppExport SEXP _TSrepr_rle_decode(SEXP xSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< List >::type x(xSEXP);
+    rcpp_result_gen = Rcpp::wrap(rle_decode(x));
+    return rcpp_result_gen;
+END_RCPP
+}
+// rle_stats
+List rle_stats(SEXP x);
+RcppExport SEXP _TSrepr_rle_stats(SEXP xSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< SEXP >::type x(xSEXP);
+    rcpp_result_gen = Rcpp::wrap(rle_stats(x));
+    return rcpp_result_gen;
+END_RCPP
+}
 
 static const R_CallMethodDef CallEntries[] = {
+    {"_TSrepr_fourier_native", (DL_FUNC) &_TSrepr_fourier_native, 4},
+    {"_TSrepr_dwt_native", (DL_FUNC) &_TSrepr_dwt_native, 3},
     {"_TSrepr_clipping", (DL_FUNC) &_TSrepr_clipping, 1},
     {"_TSrepr_trending", (DL_FUNC) &_TSrepr_trending, 1},
     {"_TSrepr_repr_feaclip", (DL_FUNC) &_TSrepr_repr_feaclip, 1},
     {"_TSrepr_repr_featrend", (DL_FUNC) &_TSrepr_repr_featrend, 4},
     {"_TSrepr_repr_feacliptrend", (DL_FUNC) &_TSrepr_repr_feacliptrend, 4},
+    {"_TSrepr_pip_native", (DL_FUNC) &_TSrepr_pip_native, 3},
+    {"_TSrepr_pla_bottom_up_native", (DL_FUNC) &_TSrepr_pla_bottom_up_native, 2},
+    {"_TSrepr_pla_online_native", (DL_FUNC) &_TSrepr_pla_online_native, 4},
+    {"_TSrepr_sax_native", (DL_FUNC) &_TSrepr_sax_native, 6},
+    {"_TSrepr_unpack_sax", (DL_FUNC) &_TSrepr_unpack_sax, 1},
+    {"_TSrepr_sax_mindist_native", (DL_FUNC) &_TSrepr_sax_mindist_native, 4},
+    {"_TSrepr_clipping_packed", (DL_FUNC) &_TSrepr_clipping_packed, 1},
+    {"_TSrepr_trending_packed", (DL_FUNC) &_TSrepr_trending_packed, 1},
+    {"_TSrepr_unpack_bits", (DL_FUNC) &_TSrepr_unpack_bits, 1},
+    {"_TSrepr_rle_packed", (DL_FUNC) &_TSrepr_rle_packed, 1},
+    {"_TSrepr_feaclip_packed", (DL_FUNC) &_TSrepr_feaclip_packed, 1},
+    {"_TSrepr_hamming_packed", (DL_FUNC) &_TSrepr_hamming_packed, 2},
+    {"_TSrepr_lb_clipped", (DL_FUNC) &_TSrepr_lb_clipped, 2},
+    {"_TSrepr_repr_exp_native", (DL_FUNC) &_TSrepr_repr_exp_native, 4},
+    {"_TSrepr_check_native_aggr", (DL_FUNC) &_TSrepr_check_native_aggr, 1},
+    {"_TSrepr_register_aggr_native", (DL_FUNC) &_TSrepr_register_aggr_native, 2},
+    {"_TSrepr_aggr_names_native", (DL_FUNC) &_TSrepr_aggr_names_native, 0},
     {"_TSrepr_maxC", (DL_FUNC) &_TSrepr_maxC, 1},
     {"_TSrepr_minC", (DL_FUNC) &_TSrepr_minC, 1},
     {"_TSrepr_meanC", (DL_FUNC) &_TSrepr_meanC, 1},
     {"_TSrepr_sumC", (DL_FUNC) &_TSrepr_sumC, 1},
     {"_TSrepr_medianC", (DL_FUNC) &_TSrepr_medianC, 1},
+    {"_TSrepr_isax_index", (DL_FUNC) &_TSrepr_isax_index, 5},
+    {"_TSrepr_isax_knn", (DL_FUNC) &_TSrepr_isax_knn, 4},
+    {"_TSrepr_repr_lm_native", (DL_FUNC) &_TSrepr_repr_lm_native, 3},
+    {"_TSrepr_lm_cholesky", (DL_FUNC) &_TSrepr_lm_cholesky, 1},
+    {"_TSrepr_lm_solve_cholesky", (DL_FUNC) &_TSrepr_lm_solve_cholesky, 3},
+    {"_TSrepr_lm_robust_matrix", (DL_FUNC) &_TSrepr_lm_robust_matrix, 3},
     {"_TSrepr_mse", (DL_FUNC) &_TSrepr_mse, 2},
     {"_TSrepr_rmse", (DL_FUNC) &_TSrepr_rmse, 2},
     {"_TSrepr_mae", (DL_FUNC) &_TSrepr_mae, 2},
@@ -363,10 +958,31 @@ static const R_CallMethodDef CallEntries[] = {
     {"_TSrepr_norm_min_max", (DL_FUNC) &_TSrepr_norm_min_max, 1},
     {"_TSrepr_norm_min_max_list", (DL_FUNC) &_TSrepr_norm_min_max_list, 1},
     {"_TSrepr_denorm_min_max", (DL_FUNC) &_TSrepr_denorm_min_max, 3},
+    {"_TSrepr_norm_z_matrix", (DL_FUNC) &_TSrepr_norm_z_matrix, 1},
+    {"_TSrepr_norm_min_max_matrix", (DL_FUNC) &_TSrepr_norm_min_max_matrix, 1},
+    {"_TSrepr_denorm_z_matrix", (DL_FUNC) &_TSrepr_denorm_z_matrix, 3},
+    {"_TSrepr_denorm_min_max_matrix", (DL_FUNC) &_TSrepr_denorm_min_max_matrix, 3},
+    {"_TSrepr_norm_median_mad", (DL_FUNC) &_TSrepr_norm_median_mad, 1},
+    {"_TSrepr_norm_median_mad_list", (DL_FUNC) &_TSrepr_norm_median_mad_list, 1},
+    {"_TSrepr_denorm_median_mad", (DL_FUNC) &_TSrepr_denorm_median_mad, 3},
+    {"_TSrepr_norm_iqr", (DL_FUNC) &_TSrepr_norm_iqr, 1},
+    {"_TSrepr_norm_iqr_list", (DL_FUNC) &_TSrepr_norm_iqr_list, 1},
+    {"_TSrepr_denorm_iqr", (DL_FUNC) &_TSrepr_denorm_iqr, 3},
+    {"_TSrepr_norm_z_rolling", (DL_FUNC) &_TSrepr_norm_z_rolling, 3},
+    {"_TSrepr_repr_matrix_native", (DL_FUNC) &_TSrepr_repr_matrix_native, 6},
+    {"_TSrepr_repr_windowing_native", (DL_FUNC) &_TSrepr_repr_windowing_native, 6},
+    {"_TSrepr_repr_stream_native", (DL_FUNC) &_TSrepr_repr_stream_native, 4},
+    {"_TSrepr_repr_stream_update", (DL_FUNC) &_TSrepr_repr_stream_update, 2},
+    {"_TSrepr_repr_stream_snapshot", (DL_FUNC) &_TSrepr_repr_stream_snapshot, 1},
+    {"_TSrepr_dft_stream_native", (DL_FUNC) &_TSrepr_dft_stream_native, 4},
+    {"_TSrepr_dft_stream_update", (DL_FUNC) &_TSrepr_dft_stream_update, 2},
+    {"_TSrepr_dft_stream_snapshot", (DL_FUNC) &_TSrepr_dft_stream_snapshot, 1},
     {"_TSrepr_repr_sma", (DL_FUNC) &_TSrepr_repr_sma, 2},
     {"_TSrepr_repr_paa", (DL_FUNC) &_TSrepr_repr_paa, 3},
     {"_TSrepr_repr_seas_profile", (DL_FUNC) &_TSrepr_repr_seas_profile, 3},
     {"_TSrepr_rleC", (DL_FUNC) &_TSrepr_rleC, 1},
+    {"_TSrepr_rle_decode", (DL_FUNC) &_TSrepr_rle_decode, 1},
+    {"_TSrepr_rle_stats", (DL_FUNC) &_TSrepr_rle_stats, 1},
     {NULL, NULL, 0}
 };
 
@@ -0,0 +1,239 @@
+#include <vector>
+#include <algorithm>
+#include <cmath>
+#include <Rcpp.h>
+#include "helpers.h"
+#include "normalizations.h"
+#include "reprsClassical.h"
+#include "SAX.h"
+using namespace Rcpp;
+
+// Breakpoints of all alphabet sizes from 2 to SAX_MAX_ALPHABET computed once,
+// quantiles of the standard normal distribution rounded to 5 digits
+// (without -Inf and Inf)
+static std::vector<std::vector<double> > sax_breakpoints_table() {
+
+  std::vector<std::vector<double> > table(SAX_MAX_ALPHABET + 1);
+
+  for(int a = 2; a <= SAX_MAX_ALPHABET; a++){
+    for(int i = 1; i < a; i++){
+      double bk = R::qnorm((double) i / a, 0.0, 1.0, 1, 0);
+      table[a].push_back(std::round(bk * 1e5) / 1e5);
+    }
+  }
+
+  return table;
+}
+
+const std::vector<double>& sax_breakpoints(int a) {
+  static const std::vector<std::vector<double> > table = sax_breakpoints_table();
+  return table[a];
+}
+
+// Symbol (0-based) of the value, the number of breakpoints lower than the value
+int sax_symbol(const std::vector<double>& breakpoints, double value) {
+  return std::lower_bound(breakpoints.begin(), breakpoints.end(), value) - breakpoints.begin();
+}
+
+// The number of bits of one symbol of the alphabet of the size a
+int sax_bits(int a) {
+  int bits = 1;
+  while ((1 << bits) < a) {
+    bits++;
+  }
+  return bits;
+}
+
+// SAX symbols (0-based) of PAA pieces of the length q of n values of x,
+// pieces are optionally z-normalised by statistics of x. Time series with
+// the standard deviation at most eps is represented by the middle symbol.
+void sax_kernel(const double* x, int n, int q, int a, double eps, bool normalise, int* symbols) {
+
+  int n_paa = (n / q) + ((n % q) != 0);
+  NormStats stats = norm_stats(x, n);
+
+  if (stats.sd <= eps) {
+    // the middle letter as by round((1 + a) / 2) (rounding half to even)
+    int middle = (a % 2 == 1) ? (a + 1) / 2 : ((a / 2) % 2 == 0 ? a / 2 : (a / 2) + 1);
+    std::fill(symbols, symbols + n_paa, middle - 1);
+    return;
+  }
+
+  const std::vector<double>& breakpoints = sax_breakpoints(a);
+  std::vector<double> pieces(n_paa);
+
+  paa_kernel(x, n, q, aggr_mean, pieces.data());
+
+  for(int i = 0; i < n_paa; i++){
+    double piece = normalise ? (pieces[i] - stats.mean) / stats.sd : pieces[i];
+    symbols[i] = sax_symbol(breakpoints, piece);
+  }
+}
+
+// SAX of x returned as letters, integer codes (1-based) or symbols packed
+// to the raw vector by sax_bits(a) bits per symbol
+// [[Rcpp::export]]
+SEXP sax_native(NumericVector x, int q, int a, double eps, bool normalise, std::string type) {
+
+  if (a < 2 || a > SAX_MAX_ALPHABET) {
+    Rcpp::stop("a must be between 2 and 26!");
+  }
+  if (q < 1) {
+    Rcpp::stop("q must be positive!");
+  }
+
+  int n = x.size();
+  int n_paa = (n / q) + ((n % q) != 0);
+  std::vector<int> symbols(n_paa);
+
+  sax_kernel(x.begin(), n, q, a, eps, normalise, symbols.data());
+
+  if (type == "letters") {
+
+    CharacterVector repr(n_paa);
+    for(int i = 0; i < n_paa; i++){
+      repr[i] = std::string(1, (char) ('a' + symbols[i]));
+    }
+    return repr;
+
+  } else if (type == "integer") {
+
+    IntegerVector repr(n_paa);
+    for(int i = 0; i < n_paa; i++){
+      repr[i] = symbols[i] + 1;
+    }
+    return repr;
+
+  } else if (type == "packed") {
+
+    int bits = sax_bits(a);
+    RawVector repr(((n_paa * bits) + 7) / 8);
+
+    for(int i = 0; i < n_paa; i++){
+      for(int b = 0; b < bits; b++){
+        int bit = (i * bits) + b;
+        if ((symbols[i] >> b) & 1) {
+          repr[bit / 8] |= (Rbyte) (1 << (bit % 8));
+        }
+      }
+    }
+
+    repr.attr("a") = a;
+    repr.attr("n_symbols") = n_paa;
+    return repr;
+
+  }
+
+  Rcpp::stop("return must be \"letters\", \"integer\" or \"packed\"!");
+  return R_NilValue;
+}
+
+//' @rdname unpack_sax
+//' @name unpack_sax
+//' @title Unpacks bit-packed SAX representation
+//'
+//' @description The \code{unpack_sax} returns integer codes of symbols of the bit-packed SAX word
+//' (created by \code{repr_sax(..., return = "packed")}).
+//'
+//' @return the integer vector of codes of symbols (1 is the letter "a")
+//'
+//' @param x the raw vector of the bit-packed SAX representation
+//'
+//' @seealso \code{\link[TSrepr]{repr_sax}}
+//'
+//' @author Peter Laurinec, <tsreprpackage@gmail.com>
+//'
+//' @examples
+//' unpack_sax(repr_sax(rnorm(48), q = 4, a = 5, return = "packed"))
+//'
+//' @useDynLib TSrepr
+//' @export unpack_sax
+// [[Rcpp::export]]
+IntegerVector unpack_sax(RawVector x) {
+
+  if (!x.hasAttribute("a") || !x.hasAttribute("n_symbols")) {
+    Rcpp::stop("x must be packed SAX representation!");
+  }
+
+  int a = Rcpp::as<int>(x.attr("a"));
+  int n_symbols = Rcpp::as<int>(x.attr("n_symbols"));
+  int bits = sax_bits(a);
+  IntegerVector symbols(n_symbols);
+
+  if (x.size() != ((n_symbols * bits) + 7) / 8) {
+    Rcpp::stop("x must be packed SAX representation!");
+  }
+
+  for(int i = 0; i < n_symbols; i++){
+    int symbol = 0;
+    for(int b = 0; b < bits; b++){
+      int bit = (i * bits) + b;
+      symbol |= ((x[bit / 8] >> (bit % 8)) & 1) << b;
+    }
+    symbols[i] = symbol + 1;
+  }
+
+  return symbols;
+}
+
+// Lookup tables of distances of pairs of symbols (0-based) of all alphabet
+// sizes computed once, the distance of symbols r < c is
+// breakpoints[c - 1] - breakpoints[r] and adjacent symbols have zero distance
+static std::vector<std::vector<double> > sax_dist_tables() {
+
+  std::vector<std::vector<double> > tables(SAX_MAX_ALPHABET + 1);
+
+  for(int a = 2; a <= SAX_MAX_ALPHABET; a++){
+    const std::vector<double>& breakpoints = sax_breakpoints(a);
+    tables[a].assign(a * a, 0);
+
+    for(int r = 0; r < a; r++){
+      for(int c = r + 2; c < a; c++){
+        tables[a][r * a + c] = tables[a][c * a + r] = breakpoints[c - 1] - breakpoints[r];
+      }
+    }
+  }
+
+  return tables;
+}
+
+// MINDIST of SAX words x and y (0-based symbols) of the length w
+// of time series of the length n
+double sax_mindist_kernel(const int* x, const int* y, int w, int n, int a) {
+
+  static const std::vector<std::vector<double> > tables = sax_dist_tables();
+  const double* table = tables[a].data();
+  double dist = 0;
+
+  for(int i = 0; i < w; i++){
+    double d = table[x[i] * a + y[i]];
+    dist += d * d;
+  }
+
+  return std::sqrt(((double) n / w) * dist);
+}
+
+// MINDIST of SAX words given by integer codes (1-based)
+// [[Rcpp::export]]
+double sax_mindist_native(IntegerVector x, IntegerVector y, int n, int a) {
+
+  if (a < 2 || a > SAX_MAX_ALPHABET) {
+    Rcpp::stop("a must be between 2 and 26!");
+  }
+  if (x.size() != y.size()) {
+    Rcpp::stop("x and y must have the same length!");
+  }
+
+  int w = x.size();
+  std::vector<int> sx(w), sy(w);
+
+  for(int i = 0; i < w; i++){
+    if (x[i] < 1 || x[i] > a || y[i] < 1 || y[i] > a) {
+      Rcpp::stop("x and y must be SAX words of the alphabet of the size a!");
+    }
+    sx[i] = x[i] - 1;
+    sy[i] = y[i] - 1;
+  }
+
+  return sax_mindist_kernel(sx.data(), sy.data(), w, n, a);
+}
@@ -0,0 +1,17 @@
+#ifndef TSREPR_SAX_H
+#define TSREPR_SAX_H
+
+#include <vector>
+#include <Rcpp.h>
+using namespace Rcpp;
+
+// the maximal alphabet size (the number of letters)
+const int SAX_MAX_ALPHABET = 26;
+
+const std::vector<double>& sax_breakpoints(int a);
+int sax_symbol(const std::vector<double>& breakpoints, double value);
+int sax_bits(int a);
+double sax_mindist_kernel(const int* x, const int* y, int w, int n, int a);
+void sax_kernel(const double* x, int n, int q, int a, double eps, bool normalise, int* symbols);
+
+#endif
@@ -0,0 +1,417 @@
+#include <numeric>
+#include <algorithm>
+#include <Rcpp.h>
+#include "bitLevel.h"
+using namespace Rcpp;
+
+BitLevel::BitLevel(int n) : n(n), clipped(false), threshold(NA_REAL), words((n + 63) / 64, 0) {}
+
+BitLevel BitLevel::clipping(const double* x, int n) {
+  BitLevel bits(n);
+
+  bits.clipped = true;
+  bits.threshold = std::accumulate(x, x + n, 0.0) / n;
+
+  for(int i = 0; i < n; ++i) {
+    if (x[i] > bits.threshold) {
+      bits.set(i);
+    }
+  }
+
+  return bits;
+}
+
+BitLevel BitLevel::trending(const double* x, int n) {
+  BitLevel bits(std::max(n - 1, 0));
+
+  for(int i = 0; i < n - 1; i++){
+    if ((x[i] - x[i+1]) < 0) {
+      bits.set(i);
+    }
+  }
+
+  return bits;
+}
+
+int BitLevel::count_ones() const {
+  int count = 0;
+
+  for(size_t k = 0; k < words.size(); k++){
+    count += popcount64(words[k]);
+  }
+
+  return count;
+}
+
+int BitLevel::next_boundary(int i) const {
+  // bits different from the bit at i are set in w
+  uint64_t flip = get(i) ? ~(uint64_t) 0 : 0;
+  size_t k = i >> 6;
+  uint64_t w = (words[k] ^ flip) & (~(uint64_t) 0 << (i & 63));
+
+  while (w == 0) {
+    k++;
+    if (k == words.size()) {
+      return n;
+    }
+    w = words[k] ^ flip;
+  }
+
+  return std::min((int) (k * 64) + ctz64(w), n);
+}
+
+int BitLevel::n_runs() const {
+  if (n == 0) {
+    return 0;
+  }
+
+  // boundaries are ones of x XOR (x shifted by one)
+  int count = 1;
+  for(size_t k = 0; k < words.size(); k++){
+    uint64_t shifted = words[k] >> 1;
+    if (k + 1 < words.size()) {
+      shifted |= words[k + 1] << 63;
+    }
+    uint64_t boundaries = words[k] ^ shifted;
+    int valid = std::min(64, n - 1 - (int) (k * 64));
+    if (valid < 64) {
+      boundaries &= valid > 0 ? (~(uint64_t) 0 >> (64 - valid)) : 0;
+    }
+    count += popcount64(boundaries);
+  }
+
+  return count;
+}
+
+int BitLevel::hamming(const BitLevel& other) const {
+  int dist = 0;
+
+  for(size_t k = 0; k < words.size(); k++){
+    dist += popcount64(words[k] ^ other.words[k]);
+  }
+
+  return dist;
+}
+
+void BitLevel::feaclip(double* repr) const {
+  int max_1 = 0, max_0 = 0, n_run = 0;
+  int first_value = 0, first_length = 0, last_value = 0, last_length = 0;
+
+  for (int i = 0; i < n;) {
+    int end = next_boundary(i);
+    int value = get(i), length = end - i;
+
+    if (value == 1) {
+      max_1 = std::max(max_1, length);
+    } else {
+      max_0 = std::max(max_0, length);
+    }
+    if (n_run == 0) {
+      first_value = value;
+      first_length = length;
+    }
+    last_value = value;
+    last_length = length;
+    n_run++;
+    i = end;
+  }
+
+  repr[0] = max_1;
+  repr[1] = count_ones();
+  repr[2] = max_0;
+  repr[3] = n_run - 1;
+  repr[4] = first_value == 0 ? first_length : 0;
+  repr[5] = last_value == 0 ? last_length : 0;
+  repr[6] = first_value == 1 ? first_length : 0;
+  repr[7] = last_value == 1 ? last_length : 0;
+}
+
+// words are stored to the raw vector byte by byte from the lowest byte,
+// so the stored representation does not depend on the endianness
+RawVector bits_to_r(const BitLevel& bits) {
+  RawVector x(bits.words.size() * 8);
+
+  for(size_t k = 0; k < bits.words.size(); k++){
+    for(int b = 0; b < 8; b++){
+      x[k * 8 + b] = (Rbyte) ((bits.words[k] >> (8 * b)) & 0xFF);
+    }
+  }
+
+  x.attr("n_bits") = bits.n;
+  x.attr("type") = bits.clipped ? "clipping" : "trending";
+  x.attr("threshold") = bits.threshold;
+
+  return x;
+}
+
+BitLevel bits_from_r(RawVector x) {
+  if (!x.hasAttribute("n_bits") || !x.hasAttribute("type")) {
+    Rcpp::stop("x must be bit-level representation created by clipping_packed or trending_packed!");
+  }
+
+  int n = Rcpp::as<int>(x.attr("n_bits"));
+  BitLevel bits(n);
+
+  if ((int) bits.words.size() * 8 != x.size()) {
+    Rcpp::stop("x must be bit-level representation created by clipping_packed or trending_packed!");
+  }
+
+  std::string type = Rcpp::as<std::string>(x.attr("type"));
+  if (type != "clipping" && type != "trending") {
+    Rcpp::stop("x must be bit-level representation created by clipping_packed or trending_packed!");
+  }
+
+  bits.clipped = type == "clipping";
+  bits.threshold = Rcpp::as<double>(x.attr("threshold"));
+
+  for(size_t k = 0; k < bits.words.size(); k++){
+    uint64_t w = 0;
+    for(int b = 0; b < 8; b++){
+      w |= (uint64_t) x[k * 8 + b] << (8 * b);
+    }
+    bits.words[k] = w;
+  }
+
+  return bits;
+}
+
+//' @rdname clipping_packed
+//' @name clipping_packed
+//' @title Creates bit-packed bit-level (clipped or trending) representation from a vector
+//'
+//' @description The \code{clipping_packed} computes bit-packed clipped representation
+//' and the \code{trending_packed} computes bit-packed trending representation from a vector.
+//'
+//' @return the raw vector of 64-bit words (8 bytes per 64 values) with attributes
+//' \code{n_bits} (the number of values), \code{type} ("clipping" or "trending") and \code{threshold}
+//' (the mean of the clipped time series, \code{NA} for trending)
+//'
+//' @param x the numeric vector (time series)
+//'
+//' @details Bit-level representations are the same as from \code{\link[TSrepr]{clipping}} and \code{\link[TSrepr]{trending}},
+//' but they are stored by 1 bit per value instead of 32 bits.
+//' Packed representations can be used by \code{\link[TSrepr]{unpack_bits}}, \code{\link[TSrepr]{rle_packed}},
+//' \code{\link[TSrepr]{feaclip_packed}}, \code{\link[TSrepr]{hamming_packed}} and \code{\link[TSrepr]{lb_clipped}},
+//' which work with whole 64-bit words.
+//'
+//' @seealso \code{\link[TSrepr]{clipping}, \link[TSrepr]{trending}}
+//'
+//' @author Peter Laurinec, <tsreprpackage@gmail.com>
+//'
+//' @examples
+//' clipping_packed(rnorm(50))
+//' trending_packed(rnorm(50))
+//'
+//' @useDynLib TSrepr
+//' @export clipping_packed
+// [[Rcpp::export]]
+RawVector clipping_packed(NumericVector x) {
+  return bits_to_r(BitLevel::clipping(x.begin(), x.size()));
+}
+
+//' @rdname clipping_packed
+//' @export trending_packed
+// [[Rcpp::export]]
+RawVector trending_packed(NumericVector x) {
+  return bits_to_r(BitLevel::trending(x.begin(), x.size()));
+}
+
+//' @rdname unpack_bits
+//' @name unpack_bits
+//' @title Unpacks bit-packed bit-level representation
+//'
+//' @description The \code{unpack_bits} returns the integer vector of zeros and ones from bit-packed representation.
+//'
+//' @return the integer vector of zeros and ones
+//'
+//' @param x the bit-packed representation (from \code{clipping_packed} or \code{trending_packed})
+//'
+//' @seealso \code{\link[TSrepr]{clipping_packed}}
+//'
+//' @author Peter Laurinec, <tsreprpackage@gmail.com>
+//'
+//' @examples
+//' unpack_bits(clipping_packed(rnorm(50)))
+//'
+//' @useDynLib TSrepr
+//' @export unpack_bits
+// [[Rcpp::export]]
+IntegerVector unpack_bits(RawVector x) {
+  BitLevel bits = bits_from_r(x);
+  IntegerVector values(bits.n);
+
+  for(int i = 0; i < bits.n; i++){
+    values[i] = bits.get(i);
+  }
+
+  return values;
+}
+
+//' @rdname rle_packed
+//' @name rle_packed
+//' @title RLE (Run Length Encoding) of bit-packed representation
+//'
+//' @description The \code{rle_packed} computes RLE from bit-packed bit-level representation.
+//'
+//' @return the list of values and counts of zeros and ones
+//'
+//' @param x the bit-packed representation (from \code{clipping_packed} or \code{trending_packed})
+//'
+//' @details Run boundaries are found by bit operations on whole 64-bit words.
+//'
+//' @seealso \code{\link[TSrepr]{rleC}, \link[TSrepr]{rle_stats}, \link[TSrepr]{clipping_packed}}
+//'
+//' @author Peter Laurinec, <tsreprpackage@gmail.com>
+//'
+//' @examples
+//' rle_packed(clipping_packed(rnorm(50)))
+//'
+//' @useDynLib TSrepr
+//' @export rle_packed
+// [[Rcpp::export]]
+List rle_packed(RawVector x) {
+  BitLevel bits = bits_from_r(x);
+  int N = bits.n_runs(), j = 0;
+  IntegerVector lengths(N), values(N);
+
+  for (int i = 0; i < bits.n;) {
+    int end = bits.next_boundary(i);
+    lengths[j] = end - i;
+    values[j] = bits.get(i);
+    j++;
+    i = end;
+  }
+
+  return List::create(
+    _["lengths"] = lengths,
+    _["values"] = values
+  );
+}
+
+//' @rdname feaclip_packed
+//' @name feaclip_packed
+//' @title FeaClip representation from bit-packed clipped representation
+//'
+//' @description The \code{feaclip_packed} computes FeaClip features from bit-packed clipped representation.
+//'
+//' @return the numeric vector of length 8
+//'
+//' @param x the bit-packed representation (from \code{clipping_packed})
+//'
+//' @details Features are the same as from \code{\link[TSrepr]{repr_feaclip}},
+//' the sum of run lengths of ones is computed by popcount of words and run boundaries are found by bit operations.
+//'
+//' @seealso \code{\link[TSrepr]{repr_feaclip}, \link[TSrepr]{clipping_packed}}
+//'
+//' @author Peter Laurinec, <tsreprpackage@gmail.com>
+//'
+//' @examples
+//' feaclip_packed(clipping_packed(rnorm(50)))
+//'
+//' @useDynLib TSrepr
+//' @export feaclip_packed
+// [[Rcpp::export]]
+NumericVector feaclip_packed(RawVector x) {
+  BitLevel bits = bits_from_r(x);
+  NumericVector representation(8);
+
+  if (bits.n == 0) {
+    Rcpp::stop("x must not be empty!");
+  }
+
+  bits.feaclip(representation.begin());
+
+  StringVector fea_name = StringVector::create("max_1", "sum_1", "max_0", "cross.", "f_0", "l_0", "f_1", "l_1");
+  representation.attr("names") = fea_name;
+  return representation;
+}
+
+//' @rdname hamming_packed
+//' @name hamming_packed
+//' @title Hamming distance of bit-packed representations
+//'
+//' @description The \code{hamming_packed} computes Hamming distance (the number of different bits)
+//' of two bit-packed bit-level representations.
+//'
+//' @return the integer value
+//'
+//' @param x the bit-packed representation (from \code{clipping_packed} or \code{trending_packed})
+//' @param y the bit-packed representation of the same length as x
+//'
+//' @seealso \code{\link[TSrepr]{clipping_packed}, \link[TSrepr]{lb_clipped}}
+//'
+//' @author Peter Laurinec, <tsreprpackage@gmail.com>
+//'
+//' @examples
+//' hamming_packed(clipping_packed(rnorm(50)), clipping_packed(rnorm(50)))
+//'
+//' @useDynLib TSrepr
+//' @export hamming_packed
+// [[Rcpp::export]]
+int hamming_packed(RawVector x, RawVector y) {
+  BitLevel bits_x = bits_from_r(x), bits_y = bits_from_r(y);
+
+  if (bits_x.n != bits_y.n) {
+    Rcpp::stop("x and y must have the same length!");
+  }
+
+  return bits_x.hamming(bits_y);
+}
+
+//' @rdname lb_clipped
+//' @name lb_clipped
+//' @title Lower bounding distance of a time series and clipped representation
+//'
+//' @description The \code{lb_clipped} computes lower bound of Euclidean distance
+//' between a time series and a time series represented by bit-packed clipped representation.
+//'
+//' @return the numeric value
+//'
+//' @param q the numeric vector (time series)
+//' @param x the bit-packed clipped representation (from \code{clipping_packed}) of a time series of the same length as q
+//'
+//' @details The distance is computed as
+//' \deqn{LB(q, x)  =  \sqrt{ \sum_{t: q_t > \mu,  x_t = 0  or  q_t \leq \mu,  x_t = 1} (q_t  -  \mu)^2 } ,}{LB(q, x)  =  sqrt(sum_{t: q_t > \mu,  x_t = 0  or  q_t <= \mu,  x_t = 1} (q_t  -  \mu)^2) ,}
+//' where \eqn{\mu} is the threshold of clipping (the mean of the clipped time series).
+//' It is never greater than Euclidean distance of q and the original time series.
+//' It is \code{NA} if the clipped time series contains NA values (the threshold is \code{NA}).
+//'
+//' @seealso \code{\link[TSrepr]{clipping_packed}, \link[TSrepr]{hamming_packed}}
+//'
+//' @author Peter Laurinec, <tsreprpackage@gmail.com>
+//'
+//' @references Ratanamahatana C, Keogh E, Bagnall A, Lonardi S (2005)
+//' A novel bit level time series representation with implication of similarity search and clustering.
+//' Advances in Knowledge Discovery and Data Mining, 771-777
+//'
+//' @examples
+//' x <- rnorm(50)
+//' q <- rnorm(50)
+//' lb_clipped(q, clipping_packed(x))
+//'
+//' @useDynLib TSrepr
+//' @export lb_clipped
+// [[Rcpp::export]]
+double lb_clipped(NumericVector q, RawVector x) {
+  BitLevel bits = bits_from_r(x);
+
+  if (bits.n != q.size()) {
+    Rcpp::stop("q and x must have the same length!");
+  }
+  if (!bits.clipped) {
+    Rcpp::stop("x must be clipped representation!");
+  }
+  if (ISNAN(bits.threshold)) {
+    return NA_REAL;
+  }
+
+  double dist = 0;
+
+  for(int i = 0; i < bits.n; i++){
+    if ((q[i] > bits.threshold) != bits.get(i)) {
+      dist += (q[i] - bits.threshold) * (q[i] - bits.threshold);
+    }
+  }
+
+  return sqrt(dist);
+}
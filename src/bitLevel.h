@@ -0,0 +1,83 @@
+#ifndef TSREPR_BITLEVEL_H
+#define TSREPR_BITLEVEL_H
+
+#include <vector>
+#include <stdint.h>
+#include <Rcpp.h>
+using namespace Rcpp;
+
+inline int popcount64(uint64_t w) {
+#if defined(__GNUC__) || defined(__clang__)
+  return __builtin_popcountll(w);
+#else
+  int count = 0;
+  for (; w != 0; w &= w - 1) {
+    count++;
+  }
+  return count;
+#endif
+}
+
+// index of the lowest set bit, w must not be zero
+inline int ctz64(uint64_t w) {
+#if defined(__GNUC__) || defined(__clang__)
+  return __builtin_ctzll(w);
+#else
+  int i = 0;
+  for (; (w & 1) == 0; w >>= 1) {
+    i++;
+  }
+  return i;
+#endif
+}
+
+// Bit-level (clipped or trending) representation packed by 64 values to one
+// word, the bit i is stored in the word i / 64 at the position i % 64.
+// Bits of the last word behind n are always zero.
+class BitLevel {
+public:
+  int n;
+  // clipped (true) or trending (false) representation
+  bool clipped;
+  // threshold of clipping (the mean of the clipped time series), NA for trending,
+  // NA also for the clipped time series with NA values
+  double threshold;
+  std::vector<uint64_t> words;
+
+  BitLevel(int n);
+
+  static BitLevel clipping(const double* x, int n);
+  static BitLevel trending(const double* x, int n);
+
+  bool get(int i) const {
+    return (words[i >> 6] >> (i & 63)) & 1;
+  }
+
+  void set(int i) {
+    words[i >> 6] |= (uint64_t) 1 << (i & 63);
+  }
+
+  int count_ones() const;
+  // the first index behind i with the different bit than at i, or n
+  int next_boundary(int i) const;
+  int n_runs() const;
+  int hamming(const BitLevel& other) const;
+
+  // calls f(value, length) for every run of equal bits
+  template <typename F>
+  void runs(F f) const {
+    for (int i = 0; i < n;) {
+      int end = next_boundary(i);
+      f((int) get(i), end - i);
+      i = end;
+    }
+  }
+
+  void feaclip(double* repr) const;
+};
+
+BitLevel bits_from_r(RawVector x);
+RawVector bits_to_r(const BitLevel& bits);
+List rle_packed(RawVector x);
+
+#endif
@@ -0,0 +1,344 @@
+#include <vector>
+#include <cmath>
+#include <algorithm>
+#include <Rcpp.h>
+#include "expSmoothing.h"
+using namespace Rcpp;
+
+HoltWinters::HoltWinters(const double* x, int n, int freq)
+  : x(x), n(n), freq(freq), level_start(0), season_start(freq, 0) {
+
+  // centred moving average of the first two periods as stats::decompose,
+  // the trend is defined for positions o, ..., 2 * freq - o - 1
+  int wind = 2 * freq, o = freq / 2;
+  std::vector<double> trend(wind, 0);
+
+  for(int t = o; t < wind - o; t++){
+    double sum = 0;
+    if (freq % 2 == 0) {
+      sum = 0.5 * (x[t - o] + x[t + o]);
+      for(int j = t - o + 1; j < t + o; j++){
+        sum += x[j];
+      }
+    } else {
+      for(int j = t - o; j <= t + o; j++){
+        sum += x[j];
+      }
+    }
+    trend[t] = sum / freq;
+  }
+
+  // the start level is the intercept of the linear regression of the trend
+  int m = wind - (2 * o);
+  double mean_trend = 0, mean_index = (m + 1) / 2.0;
+  for(int t = o; t < wind - o; t++){
+    mean_trend += trend[t];
+  }
+  mean_trend /= m;
+
+  double sxy = 0, sxx = 0;
+  for(int t = o; t < wind - o; t++){
+    double index = (t - o + 1) - mean_index;
+    sxy += index * (trend[t] - mean_trend);
+    sxx += index * index;
+  }
+  level_start = mean_trend - (sxx == 0 ? 0 : sxy / sxx) * mean_index;
+
+  // seasonal figure, means of detrended values of seasons centred to zero
+  std::vector<int> counts(freq, 0);
+  for(int t = o; t < wind - o; t++){
+    season_start[t % freq] += x[t] - trend[t];
+    counts[t % freq]++;
+  }
+
+  double mean_figure = 0;
+  for(int j = 0; j < freq; j++){
+    season_start[j] /= counts[j];
+    mean_figure += season_start[j];
+  }
+  mean_figure /= freq;
+
+  for(int j = 0; j < freq; j++){
+    season_start[j] -= mean_figure;
+  }
+}
+
+double HoltWinters::filter(double alpha, double gamma, double* season) const {
+
+  alpha = std::max(std::min(alpha, 1.0), 0.0);
+  gamma = std::max(std::min(gamma, 1.0), 0.0);
+
+  // seasonal coefficients of the last period in the circular buffer,
+  // the value t (from the second period) uses the coefficient (t - freq) mod freq
+  std::vector<double> s(season_start);
+  double level = level_start, sse = 0;
+
+  for(int t = freq; t < n; t++){
+    double& st = s[(t - freq) % freq];
+    double res = x[t] - (level + st);
+    sse += res * res;
+
+    level = alpha * (x[t] - st) + (1 - alpha) * level;
+    st = gamma * (x[t] - level) + (1 - gamma) * st;
+  }
+
+  if (season != NULL) {
+    for(int j = 0; j < freq; j++){
+      season[j] = s[(n + j) % freq];
+    }
+  }
+
+  return sse;
+}
+
+double HoltWinters::gradient(double alpha, double gamma, double* grad) const {
+
+  // the filter with derivatives of the level and seasonal coefficients by alpha and gamma
+  std::vector<double> s(season_start), ds_alpha(freq, 0), ds_gamma(freq, 0);
+  double level = level_start, dl_alpha = 0, dl_gamma = 0, sse = 0;
+  grad[0] = grad[1] = 0;
+
+  for(int t = freq; t < n; t++){
+    int j = (t - freq) % freq;
+    double st = s[j];
+    double res = x[t] - (level + st);
+    sse += res * res;
+    grad[0] -= 2 * res * (dl_alpha + ds_alpha[j]);
+    grad[1] -= 2 * res * (dl_gamma + ds_gamma[j]);
+
+    double new_level = alpha * (x[t] - st) + (1 - alpha) * level;
+    dl_alpha = (x[t] - st - level) - alpha * ds_alpha[j] + (1 - alpha) * dl_alpha;
+    dl_gamma = -alpha * ds_gamma[j] + (1 - alpha) * dl_gamma;
+    level = new_level;
+
+    s[j] = gamma * (x[t] - level) + (1 - gamma) * st;
+    ds_alpha[j] = -gamma * dl_alpha + (1 - gamma) * ds_alpha[j];
+    ds_gamma[j] = (x[t] - level - st) - gamma * dl_gamma + (1 - gamma) * ds_gamma[j];
+  }
+
+  return sse;
+}
+
+// Brent's minimisation of f on [lower, upper] (as stats::optimize)
+template <class F>
+static double brent_min(F f, double lower, double upper, double tol) {
+
+  const double c = (3 - std::sqrt(5.0)) * 0.5, eps = std::sqrt(2.220446e-16);
+  double a = lower, b = upper;
+  double v = a + c * (b - a), w = v, x = v;
+  double d = 0, e = 0;
+  double fx = f(x), fv = fx, fw = fx;
+
+  for(int iter = 0; iter < 200; iter++){
+    double xm = (a + b) * 0.5, tol1 = eps * std::fabs(x) + tol / 3, tol2 = tol1 * 2;
+
+    if (std::fabs(x - xm) <= tol2 - (b - a) * 0.5) {
+      break;
+    }
+
+    bool golden = true;
+    if (std::fabs(e) > tol1) {
+      // parabolic interpolation
+      double r = (x - w) * (fx - fv), q = (x - v) * (fx - fw), p = (x - v) * q - (x - w) * r;
+      q = (q - r) * 2;
+      if (q > 0) {
+        p = -p;
+      } else {
+        q = -q;
+      }
+      r = e;
+      e = d;
+      if (std::fabs(p) < std::fabs(q * 0.5 * r) && p > q * (a - x) && p < q * (b - x)) {
+        d = p / q;
+        double u = x + d;
+        if (u - a < tol2 || b - u < tol2) {
+          d = x < xm ? tol1 : -tol1;
+        }
+        golden = false;
+      }
+    }
+    if (golden) {
+      e = x < xm ? b - x : a - x;
+      d = c * e;
+    }
+
+    double u = x + (std::fabs(d) >= tol1 ? d : (d > 0 ? tol1 : -tol1));
+    double fu = f(u);
+
+    if (fu <= fx) {
+      if (u < x) {
+        b = x;
+      } else {
+        a = x;
+      }
+      v = w; fv = fw;
+      w = x; fw = fx;
+      x = u; fx = fu;
+    } else {
+      if (u < x) {
+        a = u;
+      } else {
+        b = u;
+      }
+      if (fu <= fw || w == x) {
+        v = w; fv = fw;
+        w = u; fw = fu;
+      } else if (fu <= fv || v == x || v == w) {
+        v = u; fv = fu;
+      }
+    }
+  }
+
+  return x;
+}
+
+// Projected BFGS minimisation of f (with the gradient) on the unit square from
+// the start point. Variables on bounds with gradients pointing outside are fixed,
+// the inverse Hessian approximation is reset when the set of fixed variables changes.
+template <class F>
+static void projected_bfgs(F f, double* par) {
+
+  double grad[2], h[2][2] = {{1, 0}, {0, 1}};
+  double value = f(par, grad);
+  bool fixed[2] = {false, false};
+
+  for(int iter = 0; iter < 200; iter++){
+    bool new_fixed[2];
+    for(int k = 0; k < 2; k++){
+      new_fixed[k] = (par[k] <= 0 && grad[k] > 0) || (par[k] >= 1 && grad[k] < 0);
+    }
+    if (new_fixed[0] != fixed[0] || new_fixed[1] != fixed[1]) {
+      h[0][0] = h[1][1] = 1;
+      h[0][1] = h[1][0] = 0;
+      fixed[0] = new_fixed[0];
+      fixed[1] = new_fixed[1];
+    }
+
+    double dir[2];
+    for(int k = 0; k < 2; k++){
+      dir[k] = fixed[k] ? 0 : -(h[k][0] * (fixed[0] ? 0 : grad[0]) + h[k][1] * (fixed[1] ? 0 : grad[1]));
+    }
+    // the steepest descent if the quasi-Newton direction is not a descent one
+    if (dir[0] * grad[0] + dir[1] * grad[1] >= 0) {
+      h[0][0] = h[1][1] = 1;
+      h[0][1] = h[1][0] = 0;
+      for(int k = 0; k < 2; k++){
+        dir[k] = fixed[k] ? 0 : -grad[k];
+      }
+    }
+    if (dir[0] == 0 && dir[1] == 0) {
+      break;
+    }
+
+    // backtracking line search along the projected path
+    double step = 1, trial[2], trial_grad[2], trial_value = value;
+    bool accepted = false;
+    for(int ls = 0; ls < 60; ls++){
+      double decrease = 0;
+      for(int k = 0; k < 2; k++){
+        trial[k] = std::max(std::min(par[k] + step * dir[k], 1.0), 0.0);
+        decrease += grad[k] * (trial[k] - par[k]);
+      }
+      trial_value = f(trial, trial_grad);
+      if (trial_value <= value + 1e-4 * decrease) {
+        accepted = true;
+        break;
+      }
+      step *= 0.5;
+    }
+    if (!accepted) {
+      break;
+    }
+
+    double s_k[2] = {trial[0] - par[0], trial[1] - par[1]};
+    double y_k[2] = {trial_grad[0] - grad[0], trial_grad[1] - grad[1]};
+    double improvement = value - trial_value;
+
+    std::copy(trial, trial + 2, par);
+    std::copy(trial_grad, trial_grad + 2, grad);
+    value = trial_value;
+
+    if (improvement <= 1e-14 * (std::fabs(value) + 1e-20) || (std::fabs(s_k[0]) + std::fabs(s_k[1])) <= 1e-12) {
+      break;
+    }
+
+    // BFGS update of the inverse Hessian
+    double sy = s_k[0] * y_k[0] + s_k[1] * y_k[1];
+    if (sy > 1e-16) {
+      double hy[2] = {h[0][0] * y_k[0] + h[0][1] * y_k[1], h[1][0] * y_k[0] + h[1][1] * y_k[1]};
+      double yhy = y_k[0] * hy[0] + y_k[1] * hy[1];
+      for(int i = 0; i < 2; i++){
+        for(int j = 0; j < 2; j++){
+          h[i][j] += ((sy + yhy) * s_k[i] * s_k[j]) / (sy * sy) - (hy[i] * s_k[j] + s_k[i] * hy[j]) / sy;
+        }
+      }
+    }
+  }
+}
+
+// minimum of f on [0, 1] by Brent's method, or one of bounds
+template <class F>
+static double bounded_min(F f) {
+  double x = brent_min(f, 0, 1, 1e-8), fx = f(x);
+  if (f(0.0) < fx) {
+    x = 0;
+    fx = f(0.0);
+  }
+  return f(1.0) < fx ? 1.0 : x;
+}
+
+// Factors are optimised as by stats::HoltWinters, both factors from
+// alpha = 0.3 and gamma = 0.1 by the projected BFGS (L-BFGS-B in HoltWinters),
+// one factor by Brent's method
+void HoltWinters::optimise(double& alpha, double& gamma) const {
+
+  bool opt_alpha = std::isnan(alpha), opt_gamma = std::isnan(gamma);
+
+  if (opt_alpha && opt_gamma) {
+    double par[2] = {0.3, 0.1};
+    projected_bfgs([this](const double* p, double* grad) { return gradient(p[0], p[1], grad); }, par);
+    alpha = par[0];
+    gamma = par[1];
+  } else if (opt_alpha) {
+    double g = gamma;
+    alpha = bounded_min([this, g](double a) { return filter(a, g, NULL); });
+  } else if (opt_gamma) {
+    double a = alpha;
+    gamma = bounded_min([this, a](double g) { return filter(a, g, NULL); });
+  }
+}
+
+void exp_kernel(const double* x, int n, int freq, double alpha, double gamma, double* repr) {
+
+  if (freq < 2 || n < 2 * freq) {
+    std::fill(repr, repr + std::max(freq, 0), NA_REAL);
+    return;
+  }
+
+  HoltWinters hw(x, n, freq);
+  hw.optimise(alpha, gamma);
+  hw.filter(alpha, gamma, repr);
+}
+
+// Checks the fixed smoothing factor (NA is optimised)
+void check_smoothing_factor(double factor, const char* name, bool zero) {
+  if (!std::isnan(factor) && (factor < 0 || factor > 1 || (!zero && factor == 0))) {
+    Rcpp::stop(std::string(name) + (zero ? " must be between 0 and 1!" : " must be larger than 0 and at most 1!"));
+  }
+}
+
+// Seasonal coefficients of Holt-Winters computed by exp_kernel
+// [[Rcpp::export]]
+NumericVector repr_exp_native(NumericVector x, int freq, double alpha, double gamma) {
+
+  if (freq < 2 || x.size() < 2 * freq) {
+    Rcpp::stop("time series has no or less than 2 periods");
+  }
+  check_smoothing_factor(alpha, "alpha", false);
+  check_smoothing_factor(gamma, "gamma", true);
+
+  NumericVector repr(freq);
+  exp_kernel(x.begin(), x.size(), freq, alpha, gamma, repr.begin());
+
+  return repr;
+}
@@ -0,0 +1,37 @@
+#ifndef TSREPR_EXPSMOOTHING_H
+#define TSREPR_EXPSMOOTHING_H
+
+#include <vector>
+#include <Rcpp.h>
+using namespace Rcpp;
+
+// Additive Holt-Winters exponential smoothing without the trend as
+// stats::HoltWinters(x, beta = FALSE). Start values are computed from
+// the classical decomposition of the first two periods of x.
+class HoltWinters {
+public:
+  HoltWinters(const double* x, int n, int freq);
+
+  // SSE of one-step forecasts with smoothing factors alpha and gamma,
+  // final seasonal coefficients are written to season (if not NULL)
+  double filter(double alpha, double gamma, double* season) const;
+  // SSE with its gradient by alpha and gamma (in [0, 1])
+  double gradient(double alpha, double gamma, double* grad) const;
+  // smoothing factors minimising the SSE, only NaN factors are optimised
+  void optimise(double& alpha, double& gamma) const;
+
+private:
+  const double* x;
+  int n, freq;
+  double level_start;
+  std::vector<double> season_start;
+};
+
+// Seasonal coefficients of Holt-Winters of x with optimised NaN factors,
+// NA for series shorter than two periods
+void exp_kernel(const double* x, int n, int freq, double alpha, double gamma, double* repr);
+
+// stops if the fixed smoothing factor is not in [0, 1] ((0, 1] if !zero)
+void check_smoothing_factor(double factor, const char* name, bool zero);
+
+#endif
@@ -1,8 +1,243 @@
 #include <numeric>
 #include <algorithm>
+#include <map>
+#include <cmath>
 #include <Rcpp.h>
+#include "helpers.h"
 using namespace Rcpp;
 
+double aggr_max(const double* x, int n) {
+  return *std::max_element(x, x + n);
+}
+
+double aggr_min(const double* x, int n) {
+  return *std::min_element(x, x + n);
+}
+
+double aggr_mean(const double* x, int n) {
+  return aggr_sum(x, n) / n;
+}
+
+double aggr_sum(const double* x, int n) {
+  double total = 0;
+  for(int i = 0; i < n; ++i) {
+    total += x[i];
+  }
+  return total;
+}
+
+double aggr_median(const double* x, int n) {
+  std::vector<double> y(x, x + n);
+  int half = n / 2;
+  double y1, y2;
+  if(n % 2 == 1) {
+    // median for odd length vector
+    std::nth_element(y.begin(), y.begin()+half, y.end());
+    return y[half];
+  } else {
+    // median for even length vector
+    std::nth_element(y.begin(), y.begin()+half, y.end());
+    y1 = y[half];
+    std::nth_element(y.begin(), y.begin()+half-1, y.begin()+half);
+    y2 = y[half-1];
+    return (y1 + y2) / 2.0;
+  }
+}
+
+// Quantile of the probability p (type 7 of R's quantile) of n values of x,
+// values of x are reordered
+double quantile_inplace(double* x, int n, double p) {
+  double h = (n - 1) * p;
+  int lo = (int) h;
+
+  std::nth_element(x, x + lo, x + n);
+  double q = x[lo];
+
+  if (lo + 1 < n && h > lo) {
+    // the next order statistic is the minimum of values behind lo
+    double next = *std::min_element(x + lo + 1, x + n);
+    q += (h - lo) * (next - q);
+  }
+
+  return q;
+}
+
+// Sum of powers of deviations from the mean, m[k] = sum((x - mean)^k), k = 2, 3, 4
+static void central_moments(const double* x, int n, double* m) {
+  double mean = aggr_mean(x, n);
+  m[2] = m[3] = m[4] = 0;
+  for(int i = 0; i < n; ++i) {
+    double d = x[i] - mean, d2 = d * d;
+    m[2] += d2;
+    m[3] += d2 * d;
+    m[4] += d2 * d2;
+  }
+}
+
+double aggr_var(const double* x, int n) {
+  if (n < 2) {
+    return NA_REAL;
+  }
+  double m[5];
+  central_moments(x, n, m);
+  return m[2] / (n - 1);
+}
+
+double aggr_sd(const double* x, int n) {
+  return std::sqrt(aggr_var(x, n));
+}
+
+// skewness and kurtosis as in the package moments (population moments)
+double aggr_skewness(const double* x, int n) {
+  double m[5];
+  central_moments(x, n, m);
+  return (m[3] / n) / std::pow(m[2] / n, 1.5);
+}
+
+double aggr_kurtosis(const double* x, int n) {
+  double m[5];
+  central_moments(x, n, m);
+  return n * m[4] / (m[2] * m[2]);
+}
+
+// the width of the range, max - min
+double aggr_range(const double* x, int n) {
+  std::pair<const double*, const double*> range = std::minmax_element(x, x + n);
+  return *range.second - *range.first;
+}
+
+double aggr_quantile(const double* x, int n, double p) {
+  std::vector<double> y(x, x + n);
+  return quantile_inplace(y.data(), n, p);
+}
+
+double aggr_iqr(const double* x, int n) {
+  std::vector<double> y(x, x + n);
+  double q_1 = quantile_inplace(y.data(), n, 0.25);
+  return quantile_inplace(y.data(), n, 0.75) - q_1;
+}
+
+// Built-in aggregations by names, the first five are also package helpers
+// with the suffix C (e.g. meanC)
+static const char* builtin_names[] = {"mean", "median", "sum", "min", "max",
+                                   "sd", "var", "skewness", "kurtosis", "range", "IQR"};
+static const aggr_fun builtin_funs[] = {aggr_mean, aggr_median, aggr_sum, aggr_min, aggr_max,
+                                     aggr_sd, aggr_var, aggr_skewness, aggr_kurtosis, aggr_range, aggr_iqr};
+static const int n_aggr = 11, n_helpers = 5;
+
+// Kernels registered by register_aggr
+static std::map<std::string, aggr_fun>& user_aggrs() {
+  static std::map<std::string, aggr_fun> aggrs;
+  return aggrs;
+}
+
+// Kernels are external pointers tagged by the symbol TSrepr_aggr, other
+// external pointers (e.g. handles of streams) are not called
+static aggr_fun xptr_aggr(SEXP kernel) {
+  Rcpp::XPtr<aggr_fun> fun = checked_xptr<aggr_fun>(kernel, "TSrepr_aggr",
+    "kernel must be the external pointer to the aggregation function tagged TSrepr_aggr!");
+  if (*fun == NULL) {
+    Rcpp::stop("kernel must be the external pointer to the aggregation function!");
+  }
+  return *fun;
+}
+
+static Aggregation named_aggr(std::string name, double p) {
+
+  if (name == "quantile") {
+    if (!(p >= 0 && p <= 1)) {
+      Rcpp::stop("p must be between 0 and 1!");
+    }
+    return Aggregation(aggr_quantile, p);
+  }
+
+  for(int i = 0; i < n_aggr; i++) {
+    if (name == builtin_names[i] || (i < n_helpers && name == std::string(builtin_names[i]) + "C")) {
+      return builtin_funs[i];
+    }
+  }
+
+  std::map<std::string, aggr_fun>::const_iterator user = user_aggrs().find(name);
+  if (user != user_aggrs().end()) {
+    return user->second;
+  }
+
+  Rcpp::stop("Unknown aggregation function: " + name);
+  return Aggregation();
+}
+
+// Resolves an aggregation function given from R to its native kernel.
+// Recognised are the package helpers (meanC, medianC, sumC, minC, maxC),
+// names of built-in and registered aggregations as strings (e.g. "mean",
+// "meanC" or "skewness"), aggregations created by native_aggr and external
+// pointers to kernels. Returns NULL for any other R function, so the caller
+// can fall back to calling it from C++.
+Aggregation find_aggr(SEXP func) {
+
+  if (Rf_isString(func)) {
+    return named_aggr(Rcpp::as<std::string>(func), NA_REAL);
+  }
+  if (TYPEOF(func) == EXTPTRSXP) {
+    return xptr_aggr(func);
+  }
+  if (Rf_inherits(func, "native_aggr")) {
+    List aggr(func);
+    return named_aggr(Rcpp::as<std::string>(aggr["name"]), Rcpp::as<double>(aggr["p"]));
+  }
+
+  Environment pkg = Environment::namespace_env("TSrepr");
+  for(int i = 0; i < n_helpers; i++) {
+    if (func == pkg.get(std::string(builtin_names[i]) + "C")) {
+      return builtin_funs[i];
+    }
+  }
+
+  return Aggregation();
+}
+
+// Checks the aggregation created by native_aggr
+// [[Rcpp::export]]
+bool check_native_aggr(SEXP aggr) {
+  find_aggr(aggr);
+  return true;
+}
+
+// Registers the kernel of register_aggr
+// [[Rcpp::export]]
+void register_aggr_native(std::string name, SEXP kernel) {
+
+  if (name == "quantile") {
+    Rcpp::stop("Built-in aggregation functions can not be replaced!");
+  }
+  for(int i = 0; i < n_aggr; i++) {
+    if (name == builtin_names[i] || (i < n_helpers && name == std::string(builtin_names[i]) + "C")) {
+      Rcpp::stop("Built-in aggregation functions can not be replaced!");
+    }
+  }
+
+  // the kernel is checked before the name is inserted
+  aggr_fun fun = xptr_aggr(kernel);
+  user_aggrs()[name] = fun;
+}
+
+// Names of built-in and registered aggregations
+// [[Rcpp::export]]
+CharacterVector aggr_names_native() {
+
+  CharacterVector names(n_aggr + 1 + user_aggrs().size());
+  int i = 0;
+
+  for(; i < n_aggr; i++) {
+    names[i] = builtin_names[i];
+  }
+  names[i++] = "quantile";
+  for(std::map<std::string, aggr_fun>::const_iterator user = user_aggrs().begin(); user != user_aggrs().end(); ++user) {
+    names[i++] = user->first;
+  }
+
+  return names;
+}
+
 //' @rdname fast_stat
 //' @name fast_stat
 //' @title Fast statistic functions (helpers)
@@ -22,10 +257,7 @@ using namespace Rcpp;
 //' @export maxC
 // [[Rcpp::export]]
 double maxC(NumericVector x) {
-  double max;
-  max = *std::max_element(x.begin(), x.end());
-
-  return max;
+  return aggr_max(x.begin(), x.size());
 }
 
 //' @rdname fast_stat
@@ -38,10 +270,7 @@ double maxC(NumericVector x) {
 //' @export minC
 // [[Rcpp::export]]
 double minC(NumericVector x) {
-  double min;
-  min = *std::min_element(x.begin(), x.end());
-
-  return min;
+  return aggr_min(x.begin(), x.size());
 }
 
 //' @rdname fast_stat
@@ -55,13 +284,7 @@ double minC(NumericVector x) {
 //' @export meanC
 // [[Rcpp::export]]
 double meanC(NumericVector x) {
-  int n = x.size();
-  double total = 0;
-
-  for(int i = 0; i < n; ++i) {
-    total += x[i];
-  }
-  return total / n;
+  return aggr_mean(x.begin(), x.size());
 }
 
 //' @rdname fast_stat
@@ -75,12 +298,7 @@ double meanC(NumericVector x) {
 //' @export sumC
 // [[Rcpp::export]]
 double sumC(NumericVector x) {
-  int n = x.size();
-  double total = 0;
-  for(int i = 0; i < n; ++i) {
-    total += x[i];
-  }
-  return total;
+  return aggr_sum(x.begin(), x.size());
 }
 
 //' @rdname fast_stat
@@ -94,21 +312,5 @@ double sumC(NumericVector x) {
 //' @export medianC
 // [[Rcpp::export]]
 double medianC(NumericVector x) {
-  NumericVector y = clone(x);
-  int n, half;
-  double y1, y2;
-  n = y.size();
-  half = n / 2;
-  if(n % 2 == 1) {
-    // median for odd length vector
-    std::nth_element(y.begin(), y.begin()+half, y.end());
-    return y[half];
-  } else {
-    // median for even length vector
-    std::nth_element(y.begin(), y.begin()+half, y.end());
-    y1 = y[half];
-    std::nth_element(y.begin(), y.begin()+half-1, y.begin()+half);
-    y2 = y[half-1];
-    return (y1 + y2) / 2.0;
-  }
+  return aggr_median(x.begin(), x.size());
 }
@@ -1,3 +1,6 @@
+#ifndef TSREPR_HELPERS_H
+#define TSREPR_HELPERS_H
+
 #include <Rcpp.h>
 using namespace Rcpp;
 
@@ -6,3 +9,65 @@ double maxC(NumericVector x);
 double meanC(NumericVector x);
 double medianC(NumericVector x);
 double sumC(NumericVector x);
+
+// Native aggregation kernels over a contiguous block of doubles,
+// user kernels are registered from R as external pointers to aggr_fun
+// tagged by the symbol TSrepr_aggr
+typedef double (*aggr_fun)(const double* x, int n);
+// kernels with a parameter (the probability of quantile)
+typedef double (*aggr_param_fun)(const double* x, int n, double param);
+
+double aggr_min(const double* x, int n);
+double aggr_max(const double* x, int n);
+double aggr_mean(const double* x, int n);
+double aggr_sum(const double* x, int n);
+double aggr_median(const double* x, int n);
+double aggr_sd(const double* x, int n);
+double aggr_var(const double* x, int n);
+double aggr_skewness(const double* x, int n);
+double aggr_kurtosis(const double* x, int n);
+double aggr_range(const double* x, int n);
+double aggr_iqr(const double* x, int n);
+double aggr_quantile(const double* x, int n, double p);
+
+double quantile_inplace(double* x, int n, double p);
+
+// Native aggregation, a kernel or a kernel with its parameter, called as
+// the kernel. It compares equal to the kernel it wraps (or to NULL if none).
+class Aggregation {
+public:
+  Aggregation(aggr_fun fun = NULL) : fun(fun), param_fun(NULL), param(0) {}
+  Aggregation(aggr_param_fun param_fun, double param) : fun(NULL), param_fun(param_fun), param(param) {}
+
+  double operator()(const double* x, int n) const {
+    return fun != NULL ? fun(x, n) : param_fun(x, n, param);
+  }
+
+  bool operator==(aggr_fun other) const {
+    return param_fun == NULL && fun == other;
+  }
+
+  bool operator!=(aggr_fun other) const {
+    return !(*this == other);
+  }
+
+private:
+  aggr_fun fun;
+  aggr_param_fun param_fun;
+  double param;
+};
+
+Aggregation find_aggr(SEXP func);
+
+// External pointers created by the package are tagged by the symbol of the
+// type of the object, the pointer is used only when it is not NULL and has
+// the tag, otherwise (e.g. the handle of another type) stops with the message
+template <typename T>
+Rcpp::XPtr<T> checked_xptr(SEXP x, const char* tag, const char* message) {
+  if (TYPEOF(x) != EXTPTRSXP || R_ExternalPtrTag(x) != Rf_install(tag) || R_ExternalPtrAddr(x) == NULL) {
+    Rcpp::stop(message);
+  }
+  return Rcpp::XPtr<T>(x);
+}
+
+#endif
@@ -0,0 +1,353 @@
+#include <vector>
+#include <map>
+#include <queue>
+#include <limits>
+#include <algorithm>
+#include <cmath>
+#include <Rcpp.h>
+#include "helpers.h"
+#include "normalizations.h"
+#include "reprsClassical.h"
+#include "SAX.h"
+using namespace Rcpp;
+
+// Node of the iSAX tree, the word has the symbol of every segment
+// of the cardinality 2^bits of the segment. Leaves keep indices of series,
+// internal nodes have two children split by one more bit of one segment.
+struct ISaxNode {
+  std::vector<int> symbols, bits;
+  std::vector<int> series;
+  int left, right;
+};
+
+// In-memory iSAX index of (optionally z-normalised) time series of the same
+// length. Symbols of all series are kept in the maximal cardinality 2^max_bits,
+// symbols of lower cardinalities are their leading bits, as breakpoints of
+// lower cardinalities are subset of breakpoints of the maximal one.
+class ISaxIndex {
+public:
+  int n, n_series, q, w, max_bits, leaf_size;
+  bool normalise;
+  // series and their symbols one after another
+  std::vector<double> data;
+  std::vector<int> words;
+  std::vector<int> seg_len;
+  std::vector<ISaxNode> nodes;
+  // roots of the tree (words of the cardinality 2) to nodes
+  std::map<std::vector<int>, int> roots;
+
+  ISaxIndex(NumericMatrix x, int q, int max_bits, int leaf_size, bool normalise)
+    : n(x.ncol()), n_series(x.nrow()), q(q), w((x.ncol() / q) + ((x.ncol() % q) != 0)),
+      max_bits(max_bits), leaf_size(leaf_size), normalise(normalise),
+      data((size_t) x.nrow() * x.ncol()), words((size_t) x.nrow() * w), seg_len(w) {
+
+    for(int j = 0; j < w; j++){
+      seg_len[j] = std::min(q, n - (j * q));
+    }
+
+    std::vector<double> paa(w);
+
+    for(int i = 0; i < n_series; i++){
+      double* series = &data[(size_t) i * n];
+      for(int j = 0; j < n; j++){
+        series[j] = x(i, j);
+      }
+      prepare(series, paa.data(), &words[(size_t) i * w]);
+      insert(i);
+    }
+  }
+
+  // normalises the series in place, computes its PAA and symbols
+  void prepare(double* series, double* paa, int* symbols) const {
+
+    if (normalise) {
+      norm_z_kernel(series, n, series);
+    }
+
+    paa_kernel(series, n, q, aggr_mean, paa);
+
+    const std::vector<double>& breakpoints = sax_breakpoints(1 << max_bits);
+    for(int j = 0; j < w; j++){
+      symbols[j] = sax_symbol(breakpoints, paa[j]);
+    }
+  }
+
+  // squared lower bound of the distance of series with the PAA to series of the node
+  double lower_bound(const ISaxNode& node, const double* paa) const {
+    double lb = 0;
+
+    for(int j = 0; j < w; j++){
+      int card = 1 << node.bits[j], s = node.symbols[j];
+      const std::vector<double>& breakpoints = sax_breakpoints(card);
+      double d = 0;
+
+      if (s > 0 && paa[j] < breakpoints[s - 1]) {
+        d = breakpoints[s - 1] - paa[j];
+      } else if (s < card - 1 && paa[j] > breakpoints[s]) {
+        d = paa[j] - breakpoints[s];
+      }
+
+      lb += seg_len[j] * d * d;
+    }
+
+    return lb;
+  }
+
+  // squared Euclidean distance abandoned when exceeds the limit
+  double distance(const double* query, int i, double limit) const {
+    const double* series = &data[(size_t) i * n];
+    double dist = 0;
+
+    for(int j = 0; j < n; j++){
+      double d = query[j] - series[j];
+      dist += d * d;
+      if (dist > limit) {
+        break;
+      }
+    }
+
+    return dist;
+  }
+
+private:
+  int symbol(int i, int segment, int bits) const {
+    return words[(size_t) i * w + segment] >> (max_bits - bits);
+  }
+
+  void insert(int i) {
+    std::vector<int> root_word(w);
+    for(int j = 0; j < w; j++){
+      root_word[j] = symbol(i, j, 1);
+    }
+
+    std::map<std::vector<int>, int>::iterator root = roots.find(root_word);
+    int node;
+
+    if (root == roots.end()) {
+      ISaxNode leaf;
+      leaf.symbols = root_word;
+      leaf.bits.assign(w, 1);
+      leaf.left = leaf.right = -1;
+      node = nodes.size();
+      nodes.push_back(leaf);
+      roots[root_word] = node;
+    } else {
+      node = root->second;
+    }
+
+    while (nodes[node].left != -1) {
+      node = child(node, i);
+    }
+
+    nodes[node].series.push_back(i);
+    split(node);
+  }
+
+  // the child of the internal node containing the series i
+  int child(int node, int i) const {
+    const ISaxNode& left = nodes[nodes[node].left];
+    for(int j = 0; j < w; j++){
+      if (left.bits[j] != nodes[node].bits[j]) {
+        return symbol(i, j, left.bits[j]) == left.symbols[j] ? nodes[node].left : nodes[node].right;
+      }
+    }
+    return nodes[node].left;
+  }
+
+  // splits the overfull leaf by the segment which next bit divides series most evenly,
+  // children are split recursively, leaves of the maximal cardinality and leaves
+  // which no next bit divides (e.g. equal series) are kept oversized
+  void split(int node) {
+    int size = nodes[node].series.size();
+    if (size <= leaf_size) {
+      return;
+    }
+
+    int best = -1, best_balance = size + 1;
+    for(int j = 0; j < w; j++){
+      int bits = nodes[node].bits[j];
+      if (bits == max_bits) {
+        continue;
+      }
+      int ones = 0;
+      for(int k = 0; k < size; k++){
+        ones += symbol(nodes[node].series[k], j, bits + 1) & 1;
+      }
+      int balance = std::abs((2 * ones) - size);
+      if (balance < best_balance) {
+        best = j;
+        best_balance = balance;
+      }
+    }
+
+    if (best == -1 || best_balance == size) {
+      return;
+    }
+
+    ISaxNode children[2];
+    for(int c = 0; c < 2; c++){
+      children[c].symbols = nodes[node].symbols;
+      children[c].bits = nodes[node].bits;
+      children[c].symbols[best] = (children[c].symbols[best] << 1) | c;
+      children[c].bits[best]++;
+      children[c].left = children[c].right = -1;
+    }
+    for(int k = 0; k < size; k++){
+      int i = nodes[node].series[k];
+      children[symbol(i, best, children[0].bits[best]) & 1].series.push_back(i);
+    }
+
+    int left = nodes.size();
+    nodes.push_back(children[0]);
+    nodes.push_back(children[1]);
+    nodes[node].left = left;
+    nodes[node].right = left + 1;
+    std::vector<int>().swap(nodes[node].series);
+
+    split(left);
+    split(left + 1);
+  }
+};
+
+//' @rdname isax_index
+//' @name isax_index
+//' @title iSAX index of time series
+//'
+//' @description The \code{isax_index} creates the in-memory iSAX index of time series (rows of the matrix)
+//' for the fast k nearest neighbours search by \code{isax_knn}.
+//'
+//' @return \code{isax_index} returns the external pointer to the index,
+//' \code{isax_knn} returns the list with indexes of rows of nearest neighbours (\code{index})
+//' and their Euclidean distances to the query (\code{distance}), ordered by the distance
+//'
+//' @param x the numeric matrix of time series, one time series in every row
+//' @param q the integer of the length of the "piece" in PAA
+//' @param a the integer of the maximal alphabet size (cardinality of SAX symbols), a power of two from 2 to 16
+//' @param leaf_size the integer of the maximal number of time series in one leaf of the index
+//' @param normalise z-normalise time series (and queries)? (default is TRUE)
+//' @param index the index created by \code{isax_index}
+//' @param query the numeric vector of the time series of the same length as rows of x
+//' @param k the integer of the number of nearest neighbours
+//' @param exact search exact nearest neighbours? (default is TRUE)
+//'
+//' @details The index is the tree of iSAX words, the root has children of SAX words of the alphabet of the size 2,
+//' full leaf is split to two children by increasing the cardinality of one segment
+//' (the segment dividing time series most evenly).
+//' Leaves are visited in the order of lower bounds of distances of the query to time series of leaves (MINDIST of PAA and iSAX word).
+//' Exact search stops when the lower bound of the next leaf is larger than the distance of the k-th nearest neighbour,
+//' approximate search stops when k time series were visited.
+//'
+//' @seealso \code{\link[TSrepr]{repr_sax}, \link[TSrepr]{sax_mindist}}
+//'
+//' @author Peter Laurinec, <tsreprpackage@gmail.com>
+//'
+//' @references Shieh J, Keogh E (2008)
+//' iSAX: indexing and mining terabyte sized time series.
+//' Proceedings of the 14th ACM SIGKDD International Conference on Knowledge Discovery and Data Mining - KDD'08
+//'
+//' @examples
+//' x <- matrix(rnorm(1000 * 48), nrow = 1000)
+//' index <- isax_index(x, q = 4)
+//' isax_knn(index, x[10,], k = 3)
+//' isax_knn(index, rnorm(48), k = 3, exact = FALSE)
+//'
+//' @useDynLib TSrepr
+//' @export isax_index
+// [[Rcpp::export]]
+SEXP isax_index(NumericMatrix x, int q, int a = 16, int leaf_size = 100, bool normalise = true) {
+
+  if (q < 1 || q > x.ncol()) {
+    Rcpp::stop("q must be between 1 and the number of columns of x!");
+  }
+  if (a < 2 || a > 16 || (a & (a - 1)) != 0) {
+    Rcpp::stop("a must be the power of two between 2 and 16!");
+  }
+  if (leaf_size < 1) {
+    Rcpp::stop("leaf_size must be positive!");
+  }
+
+  int max_bits = sax_bits(a);
+
+  Rcpp::XPtr<ISaxIndex> index(new ISaxIndex(x, q, max_bits, leaf_size, normalise), true,
+                               Rf_install("TSrepr_isax_index"));
+
+  return index;
+}
+
+//' @rdname isax_index
+//' @export isax_knn
+// [[Rcpp::export]]
+List isax_knn(SEXP index, NumericVector query, int k = 1, bool exact = true) {
+
+  Rcpp::XPtr<ISaxIndex> isax = checked_xptr<ISaxIndex>(index, "TSrepr_isax_index",
+                                                       "index must be created by isax_index!");
+
+  if (query.size() != isax->n) {
+    Rcpp::stop("query must have the same length as time series of the index!");
+  }
+  if (k < 1 || k > isax->n_series) {
+    Rcpp::stop("k must be between 1 and the number of time series of the index!");
+  }
+
+  std::vector<double> series(query.begin(), query.end()), paa(isax->w);
+  std::vector<int> symbols(isax->w);
+  isax->prepare(series.data(), paa.data(), symbols.data());
+
+  // nodes by lower bounds (and by positions for ties), nearest neighbours in the max-heap
+  typedef std::pair<double, int> item;
+  std::priority_queue<item, std::vector<item>, std::greater<item> > nodes;
+  std::priority_queue<item> knn;
+  int n_visited = 0;
+
+  for(std::map<std::vector<int>, int>::const_iterator root = isax->roots.begin(); root != isax->roots.end(); ++root){
+    nodes.push(item(isax->lower_bound(isax->nodes[root->second], paa.data()), root->second));
+  }
+
+  while (!nodes.empty()) {
+    item top = nodes.top();
+    nodes.pop();
+
+    double limit = (int) knn.size() == k ? knn.top().first : std::numeric_limits<double>::infinity();
+    if (top.first > limit) {
+      break;
+    }
+
+    const ISaxNode& node = isax->nodes[top.second];
+
+    if (node.left != -1) {
+      nodes.push(item(isax->lower_bound(isax->nodes[node.left], paa.data()), node.left));
+      nodes.push(item(isax->lower_bound(isax->nodes[node.right], paa.data()), node.right));
+      continue;
+    }
+
+    for(size_t s = 0; s < node.series.size(); s++){
+      int i = node.series[s];
+      double dist = isax->distance(series.data(), i, limit);
+
+      if ((int) knn.size() < k) {
+        knn.push(item(dist, i));
+      } else if (item(dist, i) < knn.top()) {
+        knn.pop();
+        knn.push(item(dist, i));
+      }
+      limit = (int) knn.size() == k ? knn.top().first : limit;
+    }
+
+    n_visited += node.series.size();
+    if (!exact && n_visited >= k) {
+      break;
+    }
+  }
+
+  int n_knn = knn.size();
+  IntegerVector nn(n_knn);
+  NumericVector distance(n_knn);
+
+  for(int i = n_knn - 1; i >= 0; i--){
+    nn[i] = knn.top().second + 1;
+    distance[i] = std::sqrt(knn.top().first);
+    knn.pop();
+  }
+
+  return List::create(_["index"] = nn, _["distance"] = distance);
+}
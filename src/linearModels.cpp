@@ -0,0 +1,599 @@
+#include <vector>
+#include <cmath>
+#include <algorithm>
+#include <Rcpp.h>
+#include "helpers.h"
+#include "linearModels.h"
+using namespace Rcpp;
+
+bool cholesky_upper(double* a, int p) {
+
+  for(int j = 0; j < p; j++){
+    double d = a[j * p + j];
+    for(int k = 0; k < j; k++){
+      d -= a[k * p + j] * a[k * p + j];
+    }
+    if (d <= 0) {
+      return false;
+    }
+    d = std::sqrt(d);
+    a[j * p + j] = d;
+
+    for(int i = j + 1; i < p; i++){
+      double s = a[j * p + i];
+      for(int k = 0; k < j; k++){
+        s -= a[k * p + j] * a[k * p + i];
+      }
+      a[j * p + i] = s / d;
+    }
+  }
+
+  // the lower triangle is zeroed, so u is the upper factor only
+  for(int i = 1; i < p; i++){
+    for(int j = 0; j < i; j++){
+      a[i * p + j] = 0;
+    }
+  }
+
+  return true;
+}
+
+void cholesky_solve(const double* u, int p, double* rhs) {
+
+  // u'z = rhs
+  for(int i = 0; i < p; i++){
+    double s = rhs[i];
+    for(int k = 0; k < i; k++){
+      s -= u[k * p + i] * rhs[k];
+    }
+    rhs[i] = s / u[i * p + i];
+  }
+
+  // u b = z
+  for(int i = p - 1; i >= 0; i--){
+    double s = rhs[i];
+    for(int k = i + 1; k < p; k++){
+      s -= u[i * p + k] * rhs[k];
+    }
+    rhs[i] = s / u[i * p + i];
+  }
+}
+
+// The number of levels of the second seasonality present in n values
+static int second_levels(int n, int freq, int freq_2) {
+  return std::min(freq_2 / freq, (n + freq - 1) / freq);
+}
+
+int lm_seasonal_size(int n, int freq, int freq_2) {
+  int n_freq = std::min(freq, n);
+  if (freq_2 == 0) {
+    return n_freq;
+  }
+  return n_freq + second_levels(n, freq, freq_2) - 1;
+}
+
+LmMethod find_lm_method(std::string method) {
+  if (method == "lm") {
+    return LM_OLS;
+  } else if (method == "rlm") {
+    return LM_HUBER;
+  } else if (method == "l1") {
+    return LM_L1;
+  }
+  Rcpp::stop("method must be \"lm\", \"rlm\" or \"l1\"!");
+  return LM_OLS;
+}
+
+// The seasonal design of repr_lm has dummy variables of all present levels of
+// the first seasonality (the value t has the level t mod freq) and of levels of
+// the second seasonality (the level (t mod freq_2) div freq) except the first one
+LmDesign LmDesign::seasonal(int n, int freq, int freq_2) {
+  LmDesign design;
+  design.type = SEASONAL;
+  design.n = n;
+  design.freq = freq;
+  design.freq_2 = freq_2;
+  design.k1 = std::min(freq, n);
+  design.k2 = freq_2 == 0 ? 1 : second_levels(n, freq, freq_2);
+  design.p = design.k1 + design.k2 - 1;
+  design.X = NULL;
+  return design;
+}
+
+LmDesign LmDesign::matrix(const double* X, int n, int p) {
+  LmDesign design;
+  design.type = MATRIX;
+  design.n = n;
+  design.p = p;
+  design.freq = design.freq_2 = design.k1 = design.k2 = 0;
+  design.X = X;
+  return design;
+}
+
+// The seasonal design: with one seasonality, coefficients are (weighted) means of
+// levels. With two, the normal equations are solved by the Schur complement of the
+// diagonal block of the first seasonality, so only the small system of second
+// seasonality levels is factorised. Sums and counts of levels are computed by one pass.
+// The model matrix: normal equations X'WX b = X'Wx are solved by the Cholesky factorisation.
+bool LmDesign::wfit(const double* x, const double* w, double* beta) const {
+
+  if (type == MATRIX) {
+    std::vector<double> xtx((size_t) p * p), xty(p);
+
+    for(int a = 0; a < p; a++){
+      const double* xa = X + (size_t) a * n;
+      for(int b = a; b < p; b++){
+        const double* xb = X + (size_t) b * n;
+        double s = 0;
+        for(int t = 0; t < n; t++){
+          s += (w == NULL ? 1 : w[t]) * xa[t] * xb[t];
+        }
+        xtx[a * p + b] = xtx[b * p + a] = s;
+      }
+      double s = 0;
+      for(int t = 0; t < n; t++){
+        s += (w == NULL ? 1 : w[t]) * xa[t] * x[t];
+      }
+      xty[a] = s;
+    }
+
+    if (!cholesky_upper(xtx.data(), p)) {
+      return false;
+    }
+    cholesky_solve(xtx.data(), p, xty.data());
+    std::copy(xty.begin(), xty.end(), beta);
+
+    return true;
+  }
+
+  std::vector<double> sum_1(k1, 0), count_1(k1, 0), sum_2(k2, 0), count_2(k2, 0);
+  // (weighted) counts of values of levels of the first (rows) and the second seasonality
+  std::vector<double> counts((size_t) k1 * k2, 0);
+
+  for(int t = 0; t < n; t++){
+    int j = t % freq, m = freq_2 == 0 ? 0 : (t % freq_2) / freq;
+    double wt = w == NULL ? 1 : w[t];
+    sum_1[j] += wt * x[t];
+    count_1[j] += wt;
+    sum_2[m] += wt * x[t];
+    count_2[m] += wt;
+    counts[j * k2 + m] += wt;
+  }
+
+  int p2 = k2 - 1;
+
+  if (p2 == 0) {
+    for(int j = 0; j < k1; j++){
+      beta[j] = sum_1[j] / count_1[j];
+    }
+    return true;
+  }
+
+  // (D2'WD2 - D2'WD1 (D1'WD1)^-1 D1'WD2) b2 = D2'Wx - D2'WD1 (D1'WD1)^-1 D1'Wx
+  std::vector<double> schur((size_t) p2 * p2, 0), b2(p2);
+
+  for(int a = 0; a < p2; a++){
+    schur[a * p2 + a] = count_2[a + 1];
+    b2[a] = sum_2[a + 1];
+    for(int j = 0; j < k1; j++){
+      double c_ja = counts[j * k2 + a + 1];
+      if (c_ja == 0) {
+        continue;
+      }
+      b2[a] -= c_ja * sum_1[j] / count_1[j];
+      for(int b = 0; b < p2; b++){
+        schur[a * p2 + b] -= c_ja * counts[j * k2 + b + 1] / count_1[j];
+      }
+    }
+  }
+
+  if (!cholesky_upper(schur.data(), p2)) {
+    return false;
+  }
+  cholesky_solve(schur.data(), p2, b2.data());
+
+  for(int j = 0; j < k1; j++){
+    double s = sum_1[j];
+    for(int a = 0; a < p2; a++){
+      s -= counts[j * k2 + a + 1] * b2[a];
+    }
+    beta[j] = s / count_1[j];
+  }
+  std::copy(b2.begin(), b2.end(), beta + k1);
+
+  return true;
+}
+
+void LmDesign::row(int t, double* xt) const {
+
+  if (type == MATRIX) {
+    for(int a = 0; a < p; a++){
+      xt[a] = X[(size_t) a * n + t];
+    }
+    return;
+  }
+
+  std::fill(xt, xt + p, 0.0);
+  int m = freq_2 == 0 ? 0 : (t % freq_2) / freq;
+  xt[t % freq] = 1;
+  if (m > 0) {
+    xt[k1 + m - 1] = 1;
+  }
+}
+
+void LmDesign::residuals(const double* x, const double* beta, double* resid) const {
+
+  if (type == MATRIX) {
+    std::copy(x, x + n, resid);
+    for(int a = 0; a < p; a++){
+      const double* xa = X + (size_t) a * n;
+      for(int t = 0; t < n; t++){
+        resid[t] -= beta[a] * xa[t];
+      }
+    }
+    return;
+  }
+
+  for(int t = 0; t < n; t++){
+    int m = freq_2 == 0 ? 0 : (t % freq_2) / freq;
+    resid[t] = x[t] - beta[t % freq] - (m == 0 ? 0 : beta[k1 + m - 1]);
+  }
+}
+
+// Huber M-estimation by IRLS as MASS::rlm (psi.huber with k, the MAD scale of
+// residuals, at most 20 iterations and the relative change of residuals at most
+// 1e-4 for the convergence) starting from the OLS solution
+static bool huber_fit(const LmDesign& design, const double* x, double k, double* beta) {
+
+  int n = design.n;
+  std::vector<double> resid(n), old_resid(n), abs_resid(n), w(n);
+
+  if (!design.wfit(x, NULL, beta)) {
+    return false;
+  }
+  design.residuals(x, beta, resid.data());
+
+  for(int iter = 0; iter < 20; iter++){
+    for(int t = 0; t < n; t++){
+      abs_resid[t] = std::fabs(resid[t]);
+    }
+    double scale = aggr_median(abs_resid.data(), n) / 0.6745;
+    if (scale == 0) {
+      break;
+    }
+
+    for(int t = 0; t < n; t++){
+      double u = abs_resid[t] / scale;
+      w[t] = u <= k ? 1 : k / u;
+    }
+
+    if (!design.wfit(x, w.data(), beta)) {
+      return false;
+    }
+    old_resid.swap(resid);
+    design.residuals(x, beta, resid.data());
+
+    double diff = 0, norm = 0;
+    for(int t = 0; t < n; t++){
+      diff += (old_resid[t] - resid[t]) * (old_resid[t] - resid[t]);
+      norm += old_resid[t] * old_resid[t];
+    }
+    if (std::sqrt(diff / std::max(1e-20, norm)) <= 1e-4) {
+      break;
+    }
+  }
+
+  return true;
+}
+
+static double l1_loss(const double* resid, int n) {
+  double loss = 0;
+  for(int t = 0; t < n; t++){
+    loss += std::fabs(resid[t]);
+  }
+  return loss;
+}
+
+// Exact fit of p linearly independent observations with the smallest absolute
+// residuals (the basic solution of the L1 problem near the current solution),
+// false if there are not p independent observations
+static bool l1_basic_fit(const LmDesign& design, const double* x, const double* resid, double* beta) {
+
+  int n = design.n, p = design.p;
+  std::vector<int> order(n);
+  for(int t = 0; t < n; t++){
+    order[t] = t;
+  }
+  std::sort(order.begin(), order.end(), [resid](int a, int b) {
+    return std::fabs(resid[a]) < std::fabs(resid[b]);
+  });
+
+  // orthonormal basis of selected rows of the design (Gram-Schmidt)
+  std::vector<double> basis, row(p), w(n, 0);
+  int n_basis = 0;
+
+  for(int i = 0; i < n && n_basis < p; i++){
+    design.row(order[i], row.data());
+
+    double norm = 0;
+    for(int a = 0; a < p; a++){
+      norm += row[a] * row[a];
+    }
+    for(int b = 0; b < n_basis; b++){
+      const double* e = &basis[(size_t) b * p];
+      double dot = 0;
+      for(int a = 0; a < p; a++){
+        dot += row[a] * e[a];
+      }
+      for(int a = 0; a < p; a++){
+        row[a] -= dot * e[a];
+      }
+    }
+    double rest = 0;
+    for(int a = 0; a < p; a++){
+      rest += row[a] * row[a];
+    }
+    if (rest <= 1e-12 * norm) {
+      continue;
+    }
+
+    for(int a = 0; a < p; a++){
+      basis.push_back(row[a] / std::sqrt(rest));
+    }
+    n_basis++;
+    w[order[i]] = 1;
+  }
+
+  return n_basis == p && design.wfit(x, w.data(), beta);
+}
+
+// L1 regression. Coefficients of one seasonality are medians of levels,
+// otherwise iteratively reweighted least squares with weights 1 / max(|r|, eps)
+// starting from the OLS solution (the solution with the lowest sum of absolute
+// residuals is kept and iterations stop when the sum does not decrease),
+// polished by basic solutions of observations with the smallest residuals
+static bool l1_fit(const LmDesign& design, const double* x, double* beta) {
+
+  int n = design.n, p = design.p;
+
+  if (design.type == LmDesign::SEASONAL && design.k2 == 1) {
+    std::vector<std::vector<double> > levels(design.k1);
+    for(int t = 0; t < n; t++){
+      levels[t % design.freq].push_back(x[t]);
+    }
+    for(int j = 0; j < design.k1; j++){
+      beta[j] = aggr_median(levels[j].data(), levels[j].size());
+    }
+    return true;
+  }
+
+  std::vector<double> resid(n), w(n), candidate(p);
+
+  if (!design.wfit(x, NULL, beta)) {
+    return false;
+  }
+  design.residuals(x, beta, resid.data());
+
+  double loss = l1_loss(resid.data(), n);
+  double eps = 1e-10 * std::max(loss / n, 1e-300);
+
+  for(int iter = 0; iter < 500 && loss > 0; iter++){
+    for(int t = 0; t < n; t++){
+      w[t] = 1 / std::max(std::fabs(resid[t]), eps);
+    }
+
+    if (!design.wfit(x, w.data(), candidate.data())) {
+      break;
+    }
+    design.residuals(x, candidate.data(), resid.data());
+
+    double new_loss = l1_loss(resid.data(), n);
+    if (!(new_loss < loss)) {
+      break;
+    }
+
+    std::copy(candidate.begin(), candidate.end(), beta);
+    bool converged = loss - new_loss <= 1e-12 * loss;
+    loss = new_loss;
+    if (converged) {
+      break;
+    }
+  }
+
+  for(int iter = 0; iter < p && loss > 0; iter++){
+    design.residuals(x, beta, resid.data());
+
+    if (!l1_basic_fit(design, x, resid.data(), candidate.data())) {
+      break;
+    }
+    design.residuals(x, candidate.data(), resid.data());
+
+    double new_loss = l1_loss(resid.data(), n);
+    if (!(new_loss < loss)) {
+      break;
+    }
+
+    std::copy(candidate.begin(), candidate.end(), beta);
+    loss = new_loss;
+  }
+
+  return true;
+}
+
+void lm_fit(const LmDesign& design, LmMethod method, const double* x, double* beta) {
+
+  bool ok = false;
+
+  switch (method) {
+  case LM_OLS:
+    ok = design.wfit(x, NULL, beta);
+    break;
+  case LM_HUBER:
+    ok = huber_fit(design, x, 2.5, beta);
+    break;
+  case LM_L1:
+    ok = l1_fit(design, x, beta);
+    break;
+  }
+
+  if (!ok) {
+    std::fill(beta, beta + design.p, NA_REAL);
+  }
+}
+
+void lm_seasonal_kernel(const double* x, int n, int freq, int freq_2, LmMethod method, double* repr) {
+  lm_fit(LmDesign::seasonal(n, freq, freq_2), method, x, repr);
+}
+
+// Checks seasonalities of the seasonal linear model, returns the second one (or 0)
+int lm_freq_2(IntegerVector freq) {
+
+  if (freq.size() < 1 || freq.size() > 2) {
+    Rcpp::stop("Number of seasonalities must be less than 3!");
+  }
+  if (freq[0] < 1) {
+    Rcpp::stop("freq must be positive!");
+  }
+  if (freq.size() == 1) {
+    return 0;
+  }
+  if (freq[0] >= freq[1]) {
+    Rcpp::stop("First seasonality must be less than second one!");
+  }
+  if (freq[1] % freq[0] != 0) {
+    Rcpp::stop("Second seasonality must be a multiple of the first one!");
+  }
+
+  return freq[1];
+}
+
+// Coefficients of the seasonal linear model of repr_lm computed by lm_seasonal_kernel
+// [[Rcpp::export]]
+NumericVector repr_lm_native(NumericVector x, IntegerVector freq, std::string method = "lm") {
+
+  LmMethod lm_method = find_lm_method(method);
+  int freq_2 = lm_freq_2(freq);
+  int n = x.size();
+
+  if (n == 0) {
+    Rcpp::stop("x must not be empty!");
+  }
+
+  NumericVector repr(lm_seasonal_size(n, freq[0], freq_2));
+
+  lm_seasonal_kernel(x.begin(), n, freq[0], freq_2, lm_method, repr.begin());
+
+  return repr;
+}
+
+// The upper triangular Cholesky factor of X'X of the design matrix X
+// [[Rcpp::export]]
+NumericMatrix lm_cholesky(NumericMatrix X) {
+
+  int n = X.nrow(), p = X.ncol();
+  std::vector<double> xtx((size_t) p * p, 0);
+  const double* x = X.begin();
+
+  for(int a = 0; a < p; a++){
+    for(int b = a; b < p; b++){
+      const double* xa = x + (size_t) a * n;
+      const double* xb = x + (size_t) b * n;
+      double s = 0;
+      for(int t = 0; t < n; t++){
+        s += xa[t] * xb[t];
+      }
+      xtx[a * p + b] = xtx[b * p + a] = s;
+    }
+  }
+
+  if (!cholesky_upper(xtx.data(), p)) {
+    Rcpp::stop("The design matrix must have full column rank!");
+  }
+
+  NumericMatrix u(p, p);
+  for(int a = 0; a < p; a++){
+    for(int b = 0; b < p; b++){
+      u(a, b) = xtx[a * p + b];
+    }
+  }
+
+  return u;
+}
+
+// OLS coefficients of all series (rows of Y) for the design matrix X
+// with the Cholesky factor U of X'X, one row of coefficients for every series
+// [[Rcpp::export]]
+NumericMatrix lm_solve_cholesky(NumericMatrix X, NumericMatrix U, NumericMatrix Y) {
+
+  int n = X.nrow(), p = X.ncol(), n_series = Y.nrow();
+
+  if (Y.ncol() != n) {
+    Rcpp::stop("Y must have the same number of columns as the number of rows of X!");
+  }
+  if (U.nrow() != p || U.ncol() != p) {
+    Rcpp::stop("U must be the Cholesky factor of X'X!");
+  }
+
+  std::vector<double> u((size_t) p * p), y(n), rhs(p);
+  for(int a = 0; a < p; a++){
+    for(int b = 0; b < p; b++){
+      u[a * p + b] = U(a, b);
+    }
+  }
+
+  NumericMatrix beta(n_series, p);
+  const double* x = X.begin();
+
+  for(int i = 0; i < n_series; i++){
+    for(int t = 0; t < n; t++){
+      y[t] = Y(i, t);
+    }
+    for(int a = 0; a < p; a++){
+      const double* xa = x + (size_t) a * n;
+      double s = 0;
+      for(int t = 0; t < n; t++){
+        s += xa[t] * y[t];
+      }
+      rhs[a] = s;
+    }
+
+    cholesky_solve(u.data(), p, rhs.data());
+
+    for(int a = 0; a < p; a++){
+      beta(i, a) = rhs[a];
+    }
+  }
+
+  return beta;
+}
+
+// Robust coefficients ("rlm" or "l1") of all series (rows of Y) for the model matrix X,
+// one row of coefficients for every series
+// [[Rcpp::export]]
+NumericMatrix lm_robust_matrix(NumericMatrix X, NumericMatrix Y, std::string method) {
+
+  LmMethod lm_method = find_lm_method(method);
+  int n = X.nrow(), p = X.ncol(), n_series = Y.nrow();
+
+  if (Y.ncol() != n) {
+    Rcpp::stop("Y must have the same number of columns as the number of rows of X!");
+  }
+
+  LmDesign design = LmDesign::matrix(X.begin(), n, p);
+  std::vector<double> y(n), beta(p);
+  NumericMatrix coefs(n_series, p);
+
+  for(int i = 0; i < n_series; i++){
+    for(int t = 0; t < n; t++){
+      y[t] = Y(i, t);
+    }
+
+    lm_fit(design, lm_method, y.data(), beta.data());
+
+    for(int a = 0; a < p; a++){
+      coefs(i, a) = beta[a];
+    }
+  }
+
+  return coefs;
+}
@@ -0,0 +1,48 @@
+#ifndef TSREPR_LINEARMODELS_H
+#define TSREPR_LINEARMODELS_H
+
+#include <Rcpp.h>
+using namespace Rcpp;
+
+// Cholesky factorisation of the symmetric positive definite p x p matrix a
+// (row-major) to the upper triangular u in place (a = u'u), false if a is not
+// positive definite. cholesky_solve solves u'u b = rhs in place of rhs.
+bool cholesky_upper(double* a, int p);
+void cholesky_solve(const double* u, int p, double* rhs);
+
+// Methods of linear regression of repr_lm: OLS ("lm"), Huber M-estimation
+// ("rlm", as MASS::rlm with psi.huber and k = 2.5) and L1 regression ("l1")
+enum LmMethod { LM_OLS, LM_HUBER, LM_L1 };
+
+LmMethod find_lm_method(std::string method);
+
+// Design of the linear model, the seasonal design of repr_lm (dummy variables
+// of the seasonality freq and of the second seasonality freq_2, or 0 for none)
+// or the dense column-major model matrix
+struct LmDesign {
+  enum Type { SEASONAL, MATRIX };
+
+  Type type;
+  int n, p;
+  int freq, freq_2, k1, k2;
+  const double* X;
+
+  static LmDesign seasonal(int n, int freq, int freq_2);
+  static LmDesign matrix(const double* X, int n, int p);
+
+  // (weighted) least squares coefficients, w is NULL for OLS,
+  // false if the (weighted) design is singular
+  bool wfit(const double* x, const double* w, double* beta) const;
+  void residuals(const double* x, const double* beta, double* resid) const;
+  // the row t of the model matrix
+  void row(int t, double* xt) const;
+};
+
+// coefficients of the linear model of the method (NA for singular designs)
+void lm_fit(const LmDesign& design, LmMethod method, const double* x, double* beta);
+
+int lm_freq_2(IntegerVector freq);
+int lm_seasonal_size(int n, int freq, int freq_2);
+void lm_seasonal_kernel(const double* x, int n, int freq, int freq_2, LmMethod method, double* repr);
+
+#endif
@@ -1,8 +1,126 @@
 #include <numeric>
 #include <algorithm>
+#include <set>
 #include <Rcpp.h>
+#include "helpers.h"
+#include "normalizations.h"
 using namespace Rcpp;
 
+// Mean, standard deviation, min and max of n values of x computed by one pass
+// through the memory. Values are processed by blocks, statistics of a block
+// (which stays in the cache) are computed by simple loops and merged with
+// statistics of previous blocks by the pairwise update of Chan et al.,
+// which is numerically stable as Welford's algorithm
+NormStats norm_stats(const double* x, int n) {
+
+  NormStats stats;
+  double m2 = 0;
+  int n_acc = 0;
+
+  stats.mean = 0;
+  stats.min = n > 0 ? x[0] : NA_REAL;
+  stats.max = n > 0 ? x[0] : NA_REAL;
+
+  for(int from = 0; from < n; from += NORM_BLOCK) {
+    int len = std::min(NORM_BLOCK, n - from);
+    const double* block = x + from;
+    double sum = 0, block_m2 = 0;
+
+    for(int i = 0; i < len; ++i) {
+      sum += block[i];
+      stats.min = block[i] < stats.min ? block[i] : stats.min;
+      stats.max = block[i] > stats.max ? block[i] : stats.max;
+    }
+
+    double block_mean = sum / len;
+
+    for(int i = 0; i < len; ++i) {
+      block_m2 += (block[i] - block_mean) * (block[i] - block_mean);
+    }
+
+    double delta = block_mean - stats.mean;
+    int n_tot = n_acc + len;
+
+    stats.mean += delta * len / n_tot;
+    m2 += block_m2 + (delta * delta * n_acc * len / n_tot);
+    n_acc = n_tot;
+  }
+
+  if (n == 0) {
+    stats.mean = NA_REAL;
+  }
+
+  // constant series has zero deviation even if its mean is rounded, NA values
+  // are skipped by min and max, so series with them are recognised by the mean
+  stats.sd = (!ISNAN(stats.mean) && stats.max == stats.min) ? 0 : sqrt(m2 / (n - 1));
+
+  return stats;
+}
+
+// Z-score of n values of x written to x_norm by one pass through x for
+// statistics and one fused scale pass, x_norm can be equal to x (in-place)
+NormStats norm_z_kernel(const double* x, int n, double* x_norm) {
+
+  NormStats stats = norm_stats(x, n);
+
+  if (stats.sd == 0) {
+
+    for(int i = 0; i < n; ++i){
+      x_norm[i] = 0;
+    }
+
+  } else {
+
+    for(int i = 0; i < n; ++i){
+      x_norm[i] = (x[i] - stats.mean) / stats.sd;
+    }
+
+  }
+
+  return stats;
+}
+
+// Min and max of n values of x by one pass
+static void min_max(const double* x, int n, double& min_x, double& max_x) {
+
+  min_x = n > 0 ? x[0] : NA_REAL;
+  max_x = n > 0 ? x[0] : NA_REAL;
+
+  for(int i = 1; i < n; ++i) {
+    min_x = x[i] < min_x ? x[i] : min_x;
+    max_x = x[i] > max_x ? x[i] : max_x;
+  }
+}
+
+// Min-max normalisation of n values of x written to x_norm, x_norm can be
+// equal to x (in-place), stats contain only min and max
+NormStats norm_min_max_kernel(const double* x, int n, double* x_norm) {
+
+  NormStats stats;
+  stats.mean = NA_REAL;
+  stats.sd = NA_REAL;
+
+  min_max(x, n, stats.min, stats.max);
+
+  double range = stats.max - stats.min;
+
+  if (range == 0) {
+
+    for(int i = 0; i < n; ++i){
+      x_norm[i] = 0;
+    }
+
+  } else {
+
+    for(int i = 0; i < n; ++i){
+      x_norm[i] = (x[i] - stats.min) / range;
+    }
+
+  }
+
+  return stats;
+}
+
 //' @rdname norm_z
 //' @name norm_z
 //' @title Z-score normalisation
@@ -27,33 +145,8 @@ NumericVector norm_z(NumericVector x) {
 
   int n = x.size();
   NumericVector x_norm(n);
-  double sum = 0, mean = 0, sd = 0;
-
-  for(int i = 0; i < n; ++i) {
-    sum += x[i];
-  }
-
-  mean = sum / n;
-
-  for(int i = 0; i < n; ++i) {
-    sd += pow(x[i] - mean, 2);
-  }
-
-  sd = sqrt(sd/(n-1));
-
-  if (sd == 0) {
-
-    for(int i = 0; i < n; ++i){
-      x_norm[i] = 0;
-    }
-
-  } else {
 
-    for(int i = 0; i < n; ++i){
-      x_norm[i] = (x[i] - mean) / sd;
-    }
-
-  }
+  norm_z_kernel(x.begin(), n, x_norm.begin());
 
   return x_norm;
 }
@@ -87,38 +180,13 @@ List norm_z_list(NumericVector x) {
 
   int n = x.size();
   NumericVector x_norm(n);
-  double sum = 0, mean = 0, sd = 0;
-
-  for(int i = 0; i < n; ++i) {
-    sum += x[i];
-  }
 
-  mean = sum / n;
-
-  for(int i = 0; i < n; ++i) {
-    sd += pow(x[i] - mean, 2);
-  }
-
-  sd = sqrt(sd/(n-1));
-
-  if (sd == 0) {
-
-    for(int i = 0; i < n; ++i){
-      x_norm[i] = 0;
-    }
-
-  } else {
-
-    for(int i = 0; i < n; ++i){
-      x_norm[i] = (x[i] - mean) / sd;
-    }
-
-  }
+  NormStats stats = norm_z_kernel(x.begin(), n, x_norm.begin());
 
   return List::create(
     _["norm_values"] = x_norm,
-    _["mean"] = mean,
-    _["sd"] = sd
+    _["mean"] = stats.mean,
+    _["sd"] = stats.sd
   );
 }
 
@@ -186,22 +254,8 @@ NumericVector norm_min_max(NumericVector x) {
 
   int n = x.size();
   NumericVector x_norm(n);
-  double max_x = *std::max_element(x.begin(), x.end());
-  double min_x = *std::min_element(x.begin(), x.end());
 
-  if ((max_x - min_x) == 0) {
-
-    for(int i = 0; i < n; ++i){
-      x_norm[i] = 0;
-    }
-
-  } else {
-
-    for(int i = 0; i < n; ++i){
-      x_norm[i] = (x[i] - min_x) / (max_x - min_x);
-    }
-
-  }
+  norm_min_max_kernel(x.begin(), n, x_norm.begin());
 
   return x_norm;
 }
@@ -235,27 +289,13 @@ List norm_min_max_list(NumericVector x) {
 
   int n = x.size();
   NumericVector x_norm(n);
-  double max_x = *std::max_element(x.begin(), x.end());
-  double min_x = *std::min_element(x.begin(), x.end());
-
-  if ((max_x - min_x) == 0) {
-
-    for(int i = 0; i < n; ++i){
-      x_norm[i] = 0;
-    }
 
-  } else {
-
-    for(int i = 0; i < n; ++i){
-      x_norm[i] = (x[i] - min_x) / (max_x - min_x);
-    }
-
-  }
+  NormStats stats = norm_min_max_kernel(x.begin(), n, x_norm.begin());
 
   return List::create(
     _["norm_values"] = x_norm,
-    _["min"] = min_x,
-    _["max"] = max_x
+    _["min"] = stats.min,
+    _["max"] = stats.max
   );
 }
 
@@ -298,3 +338,641 @@ NumericVector denorm_min_max(NumericVector x, double min, double max) {
 
   return values;
 }
+
+// Applies the normalisation kernel to every row of the matrix x, normalised
+// rows are written to x_norm (can be x), statistics of rows to stats
+static void norm_rows(NumericMatrix x, NumericMatrix x_norm, std::vector<NormStats>& stats,
+                      NormStats (*kernel)(const double* x, int n, double* x_norm)) {
+
+  int n_row = x.nrow(), n_col = x.ncol();
+  std::vector<double> row(n_col);
+
+  stats.resize(n_row);
+
+  for(int i = 0; i < n_row; i++){
+    for(int j = 0; j < n_col; j++){
+      row[j] = x(i, j);
+    }
+
+    stats[i] = kernel(row.data(), n_col, row.data());
+
+    for(int j = 0; j < n_col; j++){
+      x_norm(i, j) = row[j];
+    }
+  }
+}
+
+//' @rdname norm_z_matrix
+//' @name norm_z_matrix
+//' @title Z-score normalisation of rows of a matrix
+//'
+//' @description The \code{norm_z_matrix} normalises every row of a matrix (time series) by z-score
+//' and returns normalisation parameters of all rows.
+//'
+//' @return the list composed of:
+//'  \describe{
+//'  \item{\strong{norm_values}}{the numeric matrix of normalised time series}
+//'  \item{\strong{mean}}{the numeric vector of mean values of rows}
+//'  \item{\strong{sd}}{the numeric vector of standard deviations of rows}
+//'   }
+//'
+//' @param x the numeric matrix, where time series are in rows
+//'
+//' @seealso \code{\link[TSrepr]{norm_z_list}, \link[TSrepr]{denorm_z_matrix}, \link[TSrepr]{norm_min_max_matrix}}
+//'
+//' @author Peter Laurinec, <tsreprpackage@gmail.com>
+//'
+//' @examples
+//' norm_z_matrix(matrix(rnorm(100), ncol = 10))
+//'
+//' @useDynLib TSrepr
+//' @export norm_z_matrix
+// [[Rcpp::export]]
+List norm_z_matrix(NumericMatrix x) {
+
+  NumericMatrix x_norm(x.nrow(), x.ncol());
+  std::vector<NormStats> stats;
+
+  norm_rows(x, x_norm, stats, norm_z_kernel);
+
+  NumericVector mean(stats.size()), sd(stats.size());
+
+  for(size_t i = 0; i < stats.size(); i++){
+    mean[i] = stats[i].mean;
+    sd[i] = stats[i].sd;
+  }
+
+  return List::create(
+    _["norm_values"] = x_norm,
+    _["mean"] = mean,
+    _["sd"] = sd
+  );
+}
+
+//' @rdname norm_min_max_matrix
+//' @name norm_min_max_matrix
+//' @title Min-Max normalisation of rows of a matrix
+//'
+//' @description The \code{norm_min_max_matrix} normalises every row of a matrix (time series) by min-max method
+//' and returns normalisation parameters of all rows.
+//'
+//' @return the list composed of:
+//'  \describe{
+//'  \item{\strong{norm_values}}{the numeric matrix of normalised time series}
+//'  \item{\strong{min}}{the numeric vector of min values of rows}
+//'  \item{\strong{max}}{the numeric vector of max values of rows}
+//'   }
+//'
+//' @param x the numeric matrix, where time series are in rows
+//'
+//' @seealso \code{\link[TSrepr]{norm_min_max_list}, \link[TSrepr]{denorm_min_max_matrix}, \link[TSrepr]{norm_z_matrix}}
+//'
+//' @author Peter Laurinec, <tsreprpackage@gmail.com>
+//'
+//' @examples
+//' norm_min_max_matrix(matrix(rnorm(100), ncol = 10))
+//'
+//' @useDynLib TSrepr
+//' @export norm_min_max_matrix
+// [[Rcpp::export]]
+List norm_min_max_matrix(NumericMatrix x) {
+
+  NumericMatrix x_norm(x.nrow(), x.ncol());
+  std::vector<NormStats> stats;
+
+  norm_rows(x, x_norm, stats, norm_min_max_kernel);
+
+  NumericVector min(stats.size()), max(stats.size());
+
+  for(size_t i = 0; i < stats.size(); i++){
+    min[i] = stats[i].min;
+    max[i] = stats[i].max;
+  }
+
+  return List::create(
+    _["norm_values"] = x_norm,
+    _["min"] = min,
+    _["max"] = max
+  );
+}
+
+//' @rdname denorm_z_matrix
+//' @name denorm_z_matrix
+//' @title Z-score denormalisation of rows of a matrix
+//'
+//' @description The \code{denorm_z_matrix} denormalises every row of a matrix (time series) by z-score method
+//' with its own parameters.
+//'
+//' @return the numeric matrix of denormalised values
+//'
+//' @param x the numeric matrix, where time series are in rows
+//' @param mean the numeric vector of mean values (one for every row)
+//' @param sd the numeric vector of standard deviations (one for every row)
+//'
+//' @seealso \code{\link[TSrepr]{norm_z_matrix}, \link[TSrepr]{denorm_z}}
+//'
+//' @author Peter Laurinec, <tsreprpackage@gmail.com>
+//'
+//' @examples
+//' # Normalise rows and save normalisation parameters:
+//' norm_res <- norm_z_matrix(matrix(rnorm(100, 5, 2), ncol = 10))
+//' # Denormalise new data (e.g. forecasts) with previous computed parameters:
+//' denorm_z_matrix(matrix(rnorm(50), ncol = 5), mean = norm_res$mean, sd = norm_res$sd)
+//'
+//' @useDynLib TSrepr
+//' @export denorm_z_matrix
+// [[Rcpp::export]]
+NumericMatrix denorm_z_matrix(NumericMatrix x, NumericVector mean, NumericVector sd) {
+
+  int n_row = x.nrow(), n_col = x.ncol();
+
+  if (mean.size() != n_row || sd.size() != n_row) {
+    Rcpp::stop("mean and sd must have the same length as the number of rows of x!");
+  }
+
+  NumericMatrix values(n_row, n_col);
+
+  for(int j = 0; j < n_col; j++){
+    for(int i = 0; i < n_row; i++){
+      values(i, j) = (x(i, j) * sd[i]) + mean[i];
+    }
+  }
+
+  return values;
+}
+
+//' @rdname denorm_min_max_matrix
+//' @name denorm_min_max_matrix
+//' @title Min-Max denormalisation of rows of a matrix
+//'
+//' @description The \code{denorm_min_max_matrix} denormalises every row of a matrix (time series) by min-max method
+//' with its own parameters.
+//'
+//' @return the numeric matrix of denormalised values
+//'
+//' @param x the numeric matrix, where time series are in rows
+//' @param min the numeric vector of minimum values (one for every row)
+//' @param max the numeric vector of maximal values (one for every row)
+//'
+//' @seealso \code{\link[TSrepr]{norm_min_max_matrix}, \link[TSrepr]{denorm_min_max}}
+//'
+//' @author Peter Laurinec, <tsreprpackage@gmail.com>
+//'
+//' @examples
+//' # Normalise rows and save normalisation parameters:
+//' norm_res <- norm_min_max_matrix(matrix(rnorm(100, 5, 2), ncol = 10))
+//' # Denormalise new data (e.g. forecasts) with previous computed parameters:
+//' denorm_min_max_matrix(matrix(runif(50), ncol = 5), min = norm_res$min, max = norm_res$max)
+//'
+//' @useDynLib TSrepr
+//' @export denorm_min_max_matrix
+// [[Rcpp::export]]
+NumericMatrix denorm_min_max_matrix(NumericMatrix x, NumericVector min, NumericVector max) {
+
+  int n_row = x.nrow(), n_col = x.ncol();
+
+  if (min.size() != n_row || max.size() != n_row) {
+    Rcpp::stop("min and max must have the same length as the number of rows of x!");
+  }
+
+  NumericMatrix values(n_row, n_col);
+
+  for(int j = 0; j < n_col; j++){
+    for(int i = 0; i < n_row; i++){
+      values(i, j) = (x(i, j) * (max[i] - min[i])) + min[i];
+    }
+  }
+
+  return values;
+}
+
+// Values of x centered by center and divided by scale written to x_norm,
+// all zeros for the zero scale
+static void norm_center_scale(const double* x, int n, double center, double scale, double* x_norm) {
+
+  if (scale == 0) {
+
+    for(int i = 0; i < n; ++i){
+      x_norm[i] = 0;
+    }
+
+  } else {
+
+    for(int i = 0; i < n; ++i){
+      x_norm[i] = (x[i] - center) / scale;
+    }
+
+  }
+}
+
+// Stops if there are no values, returns true if any value is NA, then both
+// parameters are NA (and so all normalised values)
+static bool robust_params_na(const double* x, int n, double& center, double& scale) {
+
+  if (n == 0) {
+    Rcpp::stop("x must not be empty!");
+  }
+
+  for(int i = 0; i < n; ++i){
+    if (ISNAN(x[i])) {
+      center = NA_REAL;
+      scale = NA_REAL;
+      return true;
+    }
+  }
+
+  return false;
+}
+
+// Median and MAD (scaled by 1.4826 as R's mad) of n values of x
+static void median_mad(const double* x, int n, double& median, double& mad) {
+
+  if (robust_params_na(x, n, median, mad)) {
+    return;
+  }
+
+  std::vector<double> dev(n);
+
+  median = aggr_median(x, n);
+
+  for(int i = 0; i < n; ++i){
+    dev[i] = std::fabs(x[i] - median);
+  }
+
+  mad = 1.4826 * aggr_median(dev.data(), n);
+}
+
+// Median and interquartile range of n values of x
+static void median_iqr(const double* x, int n, double& median, double& iqr) {
+
+  if (robust_params_na(x, n, median, iqr)) {
+    return;
+  }
+
+  std::vector<double> y(x, x + n);
+
+  median = aggr_median(x, n);
+  iqr = quantile_inplace(y.data(), n, 0.75) - quantile_inplace(y.data(), n, 0.25);
+}
+
+//' @rdname norm_median_mad
+//' @name norm_median_mad
+//' @title Median and MAD normalisation
+//'
+//' @description The \code{norm_median_mad} normalises time series by median and MAD (median absolute deviation),
+//' which is robust to outliers (e.g. spikes in consumption).
+//' The \code{norm_median_mad_list} returns also normalisation parameters (median and MAD).
+//'
+//' @return \code{norm_median_mad} returns the numeric vector of normalised values,
+//' \code{norm_median_mad_list} returns the list composed of:
+//'  \describe{
+//'  \item{\strong{norm_values}}{the numeric vector of normalised values of time series}
+//'  \item{\strong{median}}{the median value}
+//'  \item{\strong{mad}}{the MAD value}
+//'   }
+//'
+//' @param x the numeric vector (time series)
+//'
+//' @details MAD is scaled by the constant 1.4826 as in \code{\link[stats]{mad}},
+//' so it estimates the standard deviation of normally distributed values.
+//' Time series with the zero MAD are normalised to zeros.
+//' If \code{x} contains NA values, the parameters and all normalised values are NA.
+//'
+//' @seealso \code{\link[TSrepr]{denorm_median_mad}, \link[TSrepr]{norm_iqr}, \link[TSrepr]{norm_z}}
+//'
+//' @author Peter Laurinec, <tsreprpackage@gmail.com>
+//'
+//' @examples
+//' norm_median_mad(c(rnorm(50), 100))
+//' norm_median_mad_list(c(rnorm(50), 100))
+//'
+//' @useDynLib TSrepr
+//' @export norm_median_mad
+// [[Rcpp::export]]
+NumericVector norm_median_mad(NumericVector x) {
+
+  int n = x.size();
+  NumericVector x_norm(n);
+  double median, mad;
+
+  median_mad(x.begin(), n, median, mad);
+  norm_center_scale(x.begin(), n, median, mad, x_norm.begin());
+
+  return x_norm;
+}
+
+//' @rdname norm_median_mad
+//' @export norm_median_mad_list
+// [[Rcpp::export]]
+List norm_median_mad_list(NumericVector x) {
+
+  int n = x.size();
+  NumericVector x_norm(n);
+  double median, mad;
+
+  median_mad(x.begin(), n, median, mad);
+  norm_center_scale(x.begin(), n, median, mad, x_norm.begin());
+
+  return List::create(
+    _["norm_values"] = x_norm,
+    _["median"] = median,
+    _["mad"] = mad
+  );
+}
+
+//' @rdname denorm_median_mad
+//' @name denorm_median_mad
+//' @title Median and MAD denormalisation
+//'
+//' @description The \code{denorm_median_mad} denormalises time series by median and MAD.
+//'
+//' @return the numeric vector of denormalised values
+//'
+//' @param x the numeric vector (time series)
+//' @param median the median value
+//' @param mad the MAD value
+//'
+//' @seealso \code{\link[TSrepr]{norm_median_mad}}
+//'
+//' @author Peter Laurinec, <tsreprpackage@gmail.com>
+//'
+//' @examples
+//' # Normalise values and save normalisation parameters:
+//' norm_res <- norm_median_mad_list(rnorm(50, 5, 2))
+//' # Denormalise new data with previous computed parameters:
+//' denorm_median_mad(rnorm(50), median = norm_res$median, mad = norm_res$mad)
+//'
+//' @useDynLib TSrepr
+//' @export denorm_median_mad
+// [[Rcpp::export]]
+NumericVector denorm_median_mad(NumericVector x, double median, double mad) {
+  return denorm_z(x, median, mad);
+}
+
+//' @rdname norm_iqr
+//' @name norm_iqr
+//' @title Median and IQR normalisation
+//'
+//' @description The \code{norm_iqr} normalises time series by median and IQR (interquartile range),
+//' which is robust to outliers (e.g. spikes in consumption).
+//' The \code{norm_iqr_list} returns also normalisation parameters (median and IQR).
+//'
+//' @return \code{norm_iqr} returns the numeric vector of normalised values,
+//' \code{norm_iqr_list} returns the list composed of:
+//'  \describe{
+//'  \item{\strong{norm_values}}{the numeric vector of normalised values of time series}
+//'  \item{\strong{median}}{the median value}
+//'  \item{\strong{iqr}}{the IQR value}
+//'   }
+//'
+//' @param x the numeric vector (time series)
+//'
+//' @details Quartiles are computed as by \code{\link[stats]{quantile}} (type 7).
+//' Time series with the zero IQR are normalised to zeros.
+//' If \code{x} contains NA values, the parameters and all normalised values are NA.
+//'
+//' @seealso \code{\link[TSrepr]{denorm_iqr}, \link[TSrepr]{norm_median_mad}, \link[TSrepr]{norm_z}}
+//'
+//' @author Peter Laurinec, <tsreprpackage@gmail.com>
+//'
+//' @examples
+//' norm_iqr(c(rnorm(50), 100))
+//' norm_iqr_list(c(rnorm(50), 100))
+//'
+//' @useDynLib TSrepr
+//' @export norm_iqr
+// [[Rcpp::export]]
+NumericVector norm_iqr(NumericVector x) {
+
+  int n = x.size();
+  NumericVector x_norm(n);
+  double median, iqr;
+
+  median_iqr(x.begin(), n, median, iqr);
+  norm_center_scale(x.begin(), n, median, iqr, x_norm.begin());
+
+  return x_norm;
+}
+
+//' @rdname norm_iqr
+//' @export norm_iqr_list
+// [[Rcpp::export]]
+List norm_iqr_list(NumericVector x) {
+
+  int n = x.size();
+  NumericVector x_norm(n);
+  double median, iqr;
+
+  median_iqr(x.begin(), n, median, iqr);
+  norm_center_scale(x.begin(), n, median, iqr, x_norm.begin());
+
+  return List::create(
+    _["norm_values"] = x_norm,
+    _["median"] = median,
+    _["iqr"] = iqr
+  );
+}
+
+//' @rdname denorm_iqr
+//' @name denorm_iqr
+//' @title Median and IQR denormalisation
+//'
+//' @description The \code{denorm_iqr} denormalises time series by median and IQR.
+//'
+//' @return the numeric vector of denormalised values
+//'
+//' @param x the numeric vector (time series)
+//' @param median the median value
+//' @param iqr the IQR value
+//'
+//' @seealso \code{\link[TSrepr]{norm_iqr}}
+//'
+//' @author Peter Laurinec, <tsreprpackage@gmail.com>
+//'
+//' @examples
+//' # Normalise values and save normalisation parameters:
+//' norm_res <- norm_iqr_list(rnorm(50, 5, 2))
+//' # Denormalise new data with previous computed parameters:
+//' denorm_iqr(rnorm(50), median = norm_res$median, iqr = norm_res$iqr)
+//'
+//' @useDynLib TSrepr
+//' @export denorm_iqr
+// [[Rcpp::export]]
+NumericVector denorm_iqr(NumericVector x, double median, double iqr) {
+  return denorm_z(x, median, iqr);
+}
+
+// Median of a sliding window kept in two balanced multisets, the lower
+// half has the same number or one more value than the upper half. Non-finite
+// values are only counted (NaN breaks the ordering of sets), the median of
+// the window with them is NA.
+class SlidingMedian {
+public:
+  SlidingMedian() : n_nonfinite(0) {}
+
+  void insert(double x) {
+    if (!R_FINITE(x)) {
+      n_nonfinite++;
+      return;
+    }
+    if (low.empty() || x <= *low.rbegin()) {
+      low.insert(x);
+    } else {
+      high.insert(x);
+    }
+    balance();
+  }
+
+  void erase(double x) {
+    if (!R_FINITE(x)) {
+      n_nonfinite--;
+      return;
+    }
+    std::multiset<double>::iterator it = low.find(x);
+    if (it != low.end()) {
+      low.erase(it);
+    } else {
+      it = high.find(x);
+      if (it != high.end()) {
+        high.erase(it);
+      }
+    }
+    balance();
+  }
+
+  double median() const {
+    if (n_nonfinite > 0 || low.empty()) {
+      return NA_REAL;
+    }
+    if (low.size() > high.size()) {
+      return *low.rbegin();
+    }
+    return (*low.rbegin() + *high.begin()) / 2.0;
+  }
+
+private:
+  std::multiset<double> low, high;
+  int n_nonfinite;
+
+  void balance() {
+    if (low.size() > high.size() + 1) {
+      high.insert(*low.rbegin());
+      low.erase(--low.end());
+    } else if (high.size() > low.size()) {
+      low.insert(*high.begin());
+      high.erase(high.begin());
+    }
+  }
+};
+
+//' @rdname norm_z_rolling
+//' @name norm_z_rolling
+//' @title Rolling z-score normalisation
+//'
+//' @description The \code{norm_z_rolling} normalises every value of time series by z-score
+//' computed from the trailing window of values.
+//'
+//' @return the numeric vector of normalised values
+//'
+//' @param x the numeric vector (time series)
+//' @param win_size the length of the trailing window
+//' @param center the center of the window, \code{"mean"} (default) or \code{"median"}
+//'
+//' @details The value \eqn{x_t} is normalised by the mean (or median) and the standard deviation
+//' of values \eqn{x_{t - win\_size + 1}, \dots, x_t}{x_(t - win_size + 1), ..., x_t}
+//' (first values of time series by all previous values).
+//' The mean and the standard deviation are updated by adding the new and removing the oldest value in O(1)
+//' and computed exactly from the window after every \code{win_size} updates, so rounding errors do not accumulate,
+//' the median is kept in two balanced sorted halves of the window and updated in O(log(win_size)).
+//' Values of constant windows are normalised to zero.
+//' Values of windows with missing (or infinite) values are NA, following windows without them are normalised as usual.
+//'
+//' @seealso \code{\link[TSrepr]{norm_z}, \link[TSrepr]{norm_median_mad}}
+//'
+//' @author Peter Laurinec, <tsreprpackage@gmail.com>
+//'
+//' @examples
+//' norm_z_rolling(rnorm(100), win_size = 24)
+//' norm_z_rolling(rnorm(100), win_size = 24, center = "median")
+//'
+//' @useDynLib TSrepr
+//' @export norm_z_rolling
+// [[Rcpp::export]]
+NumericVector norm_z_rolling(NumericVector x, int win_size, std::string center = "mean") {
+
+  if (win_size < 1) {
+    Rcpp::stop("win_size must be positive!");
+  }
+  if (center != "mean" && center != "median") {
+    Rcpp::stop("center must be \"mean\" or \"median\"!");
+  }
+
+  bool use_median = center == "median";
+  // count of values of the window, n_finite of them are in the mean and m2
+  int n = x.size(), count = 0, n_finite = 0, equal_run = 0, n_updates = 0;
+  double mean = 0, m2 = 0;
+  NumericVector x_norm(n);
+  SlidingMedian window;
+
+  for(int i = 0; i < n; i++){
+    // remove the oldest value
+    if (count == win_size) {
+      double old = x[i - win_size];
+      count--;
+      if (R_FINITE(old)) {
+        n_finite--;
+        if (n_finite == 0) {
+          mean = m2 = 0;
+        } else {
+          double delta = old - mean;
+          mean -= delta / n_finite;
+          m2 -= delta * (old - mean);
+        }
+      }
+      if (use_median) {
+        window.erase(old);
+      }
+    }
+
+    // add the new value
+    count++;
+    if (R_FINITE(x[i])) {
+      double delta = x[i] - mean;
+      n_finite++;
+      mean += delta / n_finite;
+      m2 += delta * (x[i] - mean);
+    }
+    if (use_median) {
+      window.insert(x[i]);
+    }
+
+    // exact statistics of the window after every win_size updates
+    if (++n_updates == win_size) {
+      n_updates = 0;
+      mean = m2 = 0;
+      if (n_finite > 0) {
+        for(int j = i - count + 1; j <= i; j++){
+          mean += R_FINITE(x[j]) ? x[j] : 0;
+        }
+        mean /= n_finite;
+        for(int j = i - count + 1; j <= i; j++){
+          m2 += R_FINITE(x[j]) ? (x[j] - mean) * (x[j] - mean) : 0;
+        }
+      }
+    }
+
+    // number of last values equal to x[i], the window is constant if it covers them all
+    equal_run = (i > 0 && x[i] == x[i-1]) ? equal_run + 1 : 1;
+
+    if (n_finite < count) {
+      x_norm[i] = NA_REAL;
+    } else if (equal_run >= count) {
+      x_norm[i] = 0;
+    } else {
+      double sd = sqrt(std::max(m2, 0.0) / (count - 1));
+      x_norm[i] = (x[i] - (use_median ? window.median() : mean)) / sd;
+    }
+  }
+
+  return x_norm;
+}
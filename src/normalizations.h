@@ -0,0 +1,21 @@
+#ifndef TSREPR_NORMALIZATIONS_H
+#define TSREPR_NORMALIZATIONS_H
+
+#include <Rcpp.h>
+using namespace Rcpp;
+
+NumericVector norm_z(NumericVector x);
+NumericVector norm_min_max(NumericVector x);
+
+// the number of values processed at once by norm_stats
+const int NORM_BLOCK = 256;
+
+struct NormStats {
+  double mean, sd, min, max;
+};
+
+NormStats norm_stats(const double* x, int n);
+NormStats norm_z_kernel(const double* x, int n, double* x_norm);
+NormStats norm_min_max_kernel(const double* x, int n, double* x_norm);
+
+#endif
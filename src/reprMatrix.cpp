@@ -0,0 +1,462 @@
+#include <numeric>
+#include <algorithm>
+#include <thread>
+#include <functional>
+#include <Rcpp.h>
+#include "helpers.h"
+#include "normalizations.h"
+#include "reprsClassical.h"
+#include "FeatureClippingTrending.h"
+#include "DFT.h"
+#include "DWT.h"
+#include "linearModels.h"
+#include "expSmoothing.h"
+#include "reprMatrix.h"
+using namespace Rcpp;
+
+static int arg_int(List args, const char* name, int default_value, bool required) {
+  if (args.containsElementNamed(name)) {
+    return Rcpp::as<int>(args[name]);
+  }
+  if (required) {
+    Rcpp::stop(std::string("argument \"") + name + "\" is missing, with no default");
+  }
+  return default_value;
+}
+
+static std::string arg_string(List args, const char* name, std::string default_value) {
+  if (args.containsElementNamed(name)) {
+    return Rcpp::as<std::string>(args[name]);
+  }
+  return default_value;
+}
+
+// smoothing factor of repr_exp, TRUE (the default) is the factor 1 as in
+// HoltWinters, NULL is optimised (NA)
+static double arg_smoothing_factor(List args, const char* name) {
+  if (!args.containsElementNamed(name)) {
+    return 1;
+  }
+  SEXP factor = args[name];
+  if (Rf_isNull(factor)) {
+    return NA_REAL;
+  }
+  return Rcpp::as<double>(factor);
+}
+
+static SEXP arg_func(List args) {
+  if (args.containsElementNamed("func")) {
+    return args["func"];
+  }
+  Rcpp::stop("argument \"func\" is missing, with no default");
+  return R_NilValue;
+}
+
+ReprMethod::ReprMethod(std::string method, List args)
+  : q(0), freq(0), freq_2(0), order(0), pieces(0), coef(0), level(0), coefficients(false), lm_method(LM_OLS), alpha(NA_REAL), gamma(NA_REAL), func(R_NilValue), aggr(NULL) {
+
+  if (method == "paa") {
+    type = PAA;
+    q = arg_int(args, "q", 0, true);
+    func = arg_func(args);
+  } else if (method == "seas_profile") {
+    type = SEAS_PROFILE;
+    freq = arg_int(args, "freq", 0, true);
+    func = arg_func(args);
+  } else if (method == "sma") {
+    type = SMA;
+    order = arg_int(args, "order", 0, true);
+    if (order < 1) {
+      Rcpp::stop("order must be positive!");
+    }
+  } else if (method == "feaclip") {
+    type = FEACLIP;
+  } else if (method == "featrend") {
+    type = FEATREND;
+    func = arg_func(args);
+    pieces = arg_int(args, "pieces", 2, false);
+    order = arg_int(args, "order", 4, false);
+  } else if (method == "feacliptrend") {
+    type = FEACLIPTREND;
+    func = arg_func(args);
+    pieces = arg_int(args, "pieces", 2, false);
+    order = arg_int(args, "order", 4, false);
+  } else if (method == "dft" || method == "dct") {
+    type = method == "dft" ? DFT : DCT;
+    coef = arg_int(args, "coef", 10, false);
+    std::string ret = arg_string(args, "return", "reconstruction");
+    if (coef < 1) {
+      Rcpp::stop("coef must be positive!");
+    }
+    if (ret != "reconstruction" && ret != "coefficients") {
+      Rcpp::stop("return must be \"reconstruction\" or \"coefficients\"!");
+    }
+    coefficients = ret == "coefficients";
+  } else if (method == "lm") {
+    type = LM;
+    if (!args.containsElementNamed("freq")) {
+      Rcpp::stop("argument \"freq\" is missing, with no default");
+    }
+    IntegerVector freqs = Rcpp::as<IntegerVector>(args["freq"]);
+    freq_2 = lm_freq_2(freqs);
+    freq = freqs[0];
+    lm_method = find_lm_method(arg_string(args, "method", "lm"));
+  } else if (method == "exp") {
+    type = EXP;
+    freq = arg_int(args, "freq", 0, true);
+    alpha = arg_smoothing_factor(args, "alpha");
+    gamma = arg_smoothing_factor(args, "gamma");
+    check_smoothing_factor(alpha, "alpha", false);
+    check_smoothing_factor(gamma, "gamma", true);
+  } else if (method == "dwt") {
+    type = DWT;
+    level = arg_int(args, "level", 4, false);
+    if (level < 1) {
+      Rcpp::stop("level must be positive!");
+    }
+    filter = dwt_filter(args.containsElementNamed("filter") ? (SEXP) args["filter"] : Rcpp::wrap("d4"));
+  } else {
+    Rcpp::stop("Unknown representation method: " + method);
+  }
+
+  if (type == PAA || type == SEAS_PROFILE || type == FEATREND || type == FEACLIPTREND) {
+    aggr = find_aggr(func);
+  }
+}
+
+int ReprMethod::size(int n) const {
+  switch (type) {
+  case PAA:
+    return (n / q) + ((n % q) != 0);
+  case SEAS_PROFILE:
+    return freq;
+  case SMA:
+    return n - order;
+  case FEACLIP:
+    return 8;
+  case FEATREND:
+    return pieces * 2;
+  case FEACLIPTREND:
+    return 8 + (pieces * 2);
+  case DFT:
+    return coefficients ? 2 * coef : coef;
+  case DCT:
+    return coef;
+  case DWT:
+    return dwt_size(n, level);
+  case LM:
+    return lm_seasonal_size(n, freq, freq_2);
+  case EXP:
+    return freq;
+  }
+  return 0;
+}
+
+void ReprMethod::check_length(int n) const {
+  if (type == SMA && size(n) < 1) {
+    Rcpp::stop("order must be less than the length of x!");
+  }
+}
+
+bool ReprMethod::native() const {
+  switch (type) {
+  case PAA:
+  case SEAS_PROFILE:
+  case FEATREND:
+  case FEACLIPTREND:
+    return aggr != NULL;
+  case SMA:
+  case FEACLIP:
+  case DFT:
+  case DCT:
+  case DWT:
+  case LM:
+  case EXP:
+    return true;
+  default:
+    return false;
+  }
+}
+
+void ReprMethod::compute(const double* x, int n, double* repr, std::vector<double>& scratch) const {
+
+  if (type == PAA && aggr != NULL) {
+    paa_kernel(x, n, q, aggr, repr);
+    return;
+  }
+  if (type == SEAS_PROFILE && aggr != NULL) {
+    seas_profile_kernel(x, n, freq, aggr, repr);
+    return;
+  }
+  if (type == SMA) {
+    sma_kernel(x, n, order, repr);
+    return;
+  }
+  if (type == FEACLIP) {
+    feaclip_kernel(x, n, repr);
+    return;
+  }
+  if (type == FEATREND && aggr != NULL) {
+    featrend_kernel(x, n, pieces, order, aggr, repr);
+    return;
+  }
+  if (type == FEACLIPTREND && aggr != NULL) {
+    feacliptrend_kernel(x, n, pieces, order, aggr, repr);
+    return;
+  }
+  if (type == DFT) {
+    dft_kernel(x, n, coef, coefficients, repr);
+    return;
+  }
+  if (type == DCT) {
+    dct_kernel(x, n, coef, coefficients, repr);
+    return;
+  }
+  if (type == LM) {
+    lm_seasonal_kernel(x, n, freq, freq_2, lm_method, repr);
+    return;
+  }
+  if (type == EXP) {
+    exp_kernel(x, n, freq, alpha, gamma, repr);
+    return;
+  }
+  if (type == DWT) {
+    if ((int) scratch.size() < n) {
+      scratch.resize(n);
+    }
+    dwt_kernel(x, n, level, filter, scratch.data(), repr);
+    return;
+  }
+
+  // methods without native kernel are computed by their exported functions
+  NumericVector x_vec(x, x + n);
+  NumericVector res;
+
+  switch (type) {
+  case PAA:
+    res = repr_paa(x_vec, q, func);
+    break;
+  case SEAS_PROFILE:
+    res = repr_seas_profile(x_vec, freq, func);
+    break;
+  case FEATREND:
+    res = repr_featrend(x_vec, func, pieces, order);
+    break;
+  case FEACLIPTREND:
+    res = wrap(repr_feacliptrend(x_vec, func, pieces, order));
+    break;
+  default:
+    break;
+  }
+
+  std::copy(res.begin(), res.end(), repr);
+}
+
+typedef NormStats (*norm_fun)(const double* x, int n, double* x_norm);
+
+static norm_fun find_norm(std::string norm) {
+  if (norm == "none") {
+    return NULL;
+  } else if (norm == "z") {
+    return norm_z_kernel;
+  } else if (norm == "min_max") {
+    return norm_min_max_kernel;
+  }
+  Rcpp::stop("Unknown normalisation method: " + norm);
+  return NULL;
+}
+
+// Length of the representation of a series of the length n computed from
+// non-overlapping windows of the length win_size and the remaining values
+static int windowed_size(const ReprMethod& repr_method, int n, int win_size) {
+  if (win_size == 0) {
+    return repr_method.size(n);
+  }
+  int n_win = n / win_size, remain = n % win_size;
+  return (n_win * repr_method.size(win_size)) + (remain == 0 ? 0 : repr_method.size(remain));
+}
+
+static void compute_windowed(const ReprMethod& repr_method, const double* x, int n,
+                             int win_size, double* repr, std::vector<double>& scratch) {
+  if (win_size == 0) {
+    repr_method.compute(x, n, repr, scratch);
+    return;
+  }
+  int n_win = n / win_size, remain = n % win_size;
+  int win_repr = repr_method.size(win_size);
+
+  for(int i = 0; i < n_win; i++){
+    repr_method.compute(x + (i * win_size), win_size, repr + (i * win_repr), scratch);
+  }
+  if (remain != 0) {
+    repr_method.compute(x + (n_win * win_size), remain, repr + (n_win * win_repr), scratch);
+  }
+}
+
+// Computes representations of rows from (including) to (excluding) of the
+// column-major matrix x into the column-major matrix repr, rows are read into
+// the contiguous buffer one by one
+static void compute_rows(const ReprMethod& repr_method, norm_fun norm,
+                         const double* x, int n_row, int n_col,
+                         int win_size, double* repr, int n_repr, int from, int to) {
+
+  std::vector<double> row(n_col), row_repr(n_repr), scratch;
+
+  for(int i = from; i < to; i++){
+    for(int j = 0; j < n_col; j++){
+      row[j] = x[i + (size_t) j * n_row];
+    }
+
+    if (norm != NULL) {
+      norm(row.data(), n_col, row.data());
+    }
+
+    compute_windowed(repr_method, row.data(), n_col, win_size, row_repr.data(), scratch);
+
+    for(int j = 0; j < n_repr; j++){
+      repr[i + (size_t) j * n_row] = row_repr[j];
+    }
+  }
+}
+
+// Computes representations of all rows of the matrix x into the one
+// preallocated matrix, rows are optionally split to windows of the length
+// win_size (0 for no windowing). Rows are split into contiguous blocks computed by
+// threads workers, methods calling the R API are computed by the main thread only
+// [[Rcpp::export]]
+NumericMatrix repr_matrix_native(NumericMatrix x, std::string method, List args,
+                                 std::string norm = "none", int threads = 1, int win_size = 0) {
+
+  if (threads < 1) {
+    Rcpp::stop("threads must be positive!");
+  }
+  if (win_size < 0) {
+    Rcpp::stop("win_size must be positive!");
+  }
+
+  ReprMethod repr_method(method, args);
+  norm_fun norm_kernel = find_norm(norm);
+
+  int n_row = x.nrow(), n_col = x.ncol();
+
+  // every window and the remainder must have the representation
+  if (win_size == 0 || win_size > n_col) {
+    repr_method.check_length(n_col);
+  } else {
+    repr_method.check_length(win_size);
+    if (n_col % win_size != 0) {
+      repr_method.check_length(n_col % win_size);
+    }
+  }
+
+  int n_repr = windowed_size(repr_method, n_col, win_size);
+
+  NumericMatrix repr(n_row, n_repr);
+  const double* x_ptr = x.begin();
+  double* repr_ptr = repr.begin();
+
+  if (!repr_method.native()) {
+    threads = 1;
+  }
+  threads = std::max(1, std::min(threads, n_row));
+
+  if (threads == 1) {
+    compute_rows(repr_method, norm_kernel, x_ptr, n_row, n_col, win_size, repr_ptr, n_repr, 0, n_row);
+  } else {
+    std::vector<std::thread> workers;
+    int block = n_row / threads, rest = n_row % threads, from = 0;
+
+    for(int t = 0; t < threads; t++){
+      int to = from + block + (t < rest);
+      workers.push_back(std::thread(compute_rows, std::cref(repr_method), norm_kernel,
+                                    x_ptr, n_row, n_col, win_size, repr_ptr, n_repr, from, to));
+      from = to;
+    }
+
+    for(size_t t = 0; t < workers.size(); t++){
+      workers[t].join();
+    }
+  }
+
+  if (repr_method.type == ReprMethod::FEACLIP && win_size == 0) {
+    colnames(repr) = CharacterVector::create("max_1", "sum_1", "max_0", "cross.", "f_0", "l_0", "f_1", "l_1");
+  }
+
+  return repr;
+}
+
+// Computes representations of windows from (including) to (excluding) of the
+// length win_size starting every stride values of x, windows are passed to
+// kernels as views of x and their representations are written to rows of the
+// column-major matrix repr
+static void compute_windows(const ReprMethod& repr_method, const double* x, int win_size, int stride,
+                            double* repr, int n_win, int n_repr, int from, int to) {
+
+  std::vector<double> win_repr(n_repr), scratch;
+
+  for(int i = from; i < to; i++){
+    repr_method.compute(x + ((size_t) i * stride), win_size, win_repr.data(), scratch);
+
+    for(int j = 0; j < n_repr; j++){
+      repr[i + (size_t) j * n_win] = win_repr[j];
+    }
+  }
+}
+
+// Computes representations of all (possibly overlapping) windows of the length
+// win_size starting every stride values of x into rows of the matrix, the
+// remaining values shorter than win_size are left out. Windows are split into
+// contiguous blocks computed by threads workers as in repr_matrix_native
+// [[Rcpp::export]]
+NumericMatrix repr_windowing_native(NumericVector x, std::string method, List args,
+                                    int win_size, int stride, int threads = 1) {
+
+  if (win_size < 1 || win_size > x.size()) {
+    Rcpp::stop("win_size must be between 1 and the length of x!");
+  }
+  if (stride < 1) {
+    Rcpp::stop("stride must be positive!");
+  }
+  if (threads < 1) {
+    Rcpp::stop("threads must be positive!");
+  }
+
+  ReprMethod repr_method(method, args);
+  repr_method.check_length(win_size);
+
+  int n_win = ((x.size() - win_size) / stride) + 1;
+  int n_repr = repr_method.size(win_size);
+
+  NumericMatrix repr(n_win, n_repr);
+  const double* x_ptr = x.begin();
+  double* repr_ptr = repr.begin();
+
+  if (!repr_method.native()) {
+    threads = 1;
+  }
+  threads = std::max(1, std::min(threads, n_win));
+
+  if (threads == 1) {
+    compute_windows(repr_method, x_ptr, win_size, stride, repr_ptr, n_win, n_repr, 0, n_win);
+  } else {
+    std::vector<std::thread> workers;
+    int block = n_win / threads, rest = n_win % threads, from = 0;
+
+    for(int t = 0; t < threads; t++){
+      int to = from + block + (t < rest);
+      workers.push_back(std::thread(compute_windows, std::cref(repr_method), x_ptr, win_size, stride,
+                                    repr_ptr, n_win, n_repr, from, to));
+      from = to;
+    }
+
+    for(size_t t = 0; t < workers.size(); t++){
+      workers[t].join();
+    }
+  }
+
+  if (repr_method.type == ReprMethod::FEACLIP) {
+    colnames(repr) = CharacterVector::create("max_1", "sum_1", "max_0", "cross.", "f_0", "l_0", "f_1", "l_1");
+  }
+
+  return repr;
+}
@@ -0,0 +1,46 @@
+#ifndef TSREPR_REPRMATRIX_H
+#define TSREPR_REPRMATRIX_H
+
+#include <vector>
+#include <Rcpp.h>
+#include "helpers.h"
+#include "linearModels.h"
+using namespace Rcpp;
+
+// Representation method with its parameters resolved from the R arguments,
+// applied to one series (row of a matrix) given by a pointer and a length
+struct ReprMethod {
+  enum Type { PAA, SEAS_PROFILE, SMA, FEACLIP, FEATREND, FEACLIPTREND, DFT, DCT, DWT, LM, EXP };
+
+  Type type;
+  int q, freq, freq_2, order, pieces, coef, level;
+  // DFT and DCT return coefficients instead of reconstructed series
+  bool coefficients;
+  // scaling filter of DWT
+  std::vector<double> filter;
+  // regression method of the seasonal linear model
+  LmMethod lm_method;
+  // smoothing factors of Holt-Winters, NaN are optimised
+  double alpha, gamma;
+  SEXP func;
+  Aggregation aggr;
+
+  ReprMethod(std::string method, List args);
+
+  // length of the representation of a series of the length n
+  int size(int n) const;
+  // true if the method is computed without calls of the R API,
+  // so it can be computed from worker threads
+  bool native() const;
+  // stops if a series of the length n has no representation (SMA of the series
+  // not longer than the order), called by the main thread before kernels
+  void check_length(int n) const;
+  // scratch is the workspace of the caller (one per thread), resized by
+  // methods which need it, so it is allocated once for all series
+  void compute(const double* x, int n, double* repr, std::vector<double>& scratch) const;
+};
+
+NumericMatrix repr_matrix_native(NumericMatrix x, std::string method, List args,
+                                 std::string norm, int threads, int win_size);
+
+#endif
@@ -0,0 +1,300 @@
+#include <numeric>
+#include <algorithm>
+#include <cmath>
+#include <Rcpp.h>
+#include "DFT.h"
+#include "reprMatrix.h"
+#include "helpers.h"
+#include "reprStream.h"
+using namespace Rcpp;
+
+ReprStream::ReprStream(std::string method, int win_size, int max_history, List args)
+  : args(args), method(method, args), win_size(win_size), max_history(max_history), n_windows(0) {
+  // every closed window must have the representation, update relies on it
+  this->method.check_length(win_size);
+  buffer.reserve(win_size);
+}
+
+int ReprStream::update(const double* x, int n, std::vector<double>& closed) {
+
+  int n_closed = 0, win_repr = method.size(win_size);
+
+  for(int i = 0; i < n;){
+    int n_add = std::min(n - i, win_size - (int) buffer.size());
+    buffer.insert(buffer.end(), x + i, x + i + n_add);
+    i += n_add;
+
+    if ((int) buffer.size() == win_size) {
+      closed.resize(closed.size() + win_repr);
+      method.compute(buffer.data(), win_size, closed.data() + (closed.size() - win_repr), scratch);
+      buffer.clear();
+      n_windows++;
+      n_closed++;
+    }
+  }
+
+  // only last max_history closed windows are kept
+  size_t n_keep = (size_t) std::min(n_closed, max_history) * win_repr;
+  history.insert(history.end(), closed.end() - n_keep, closed.end());
+  size_t max_size = (size_t) max_history * win_repr;
+  if (history.size() > max_size) {
+    history.erase(history.begin(), history.begin() + (history.size() - max_size));
+  }
+
+  return n_closed;
+}
+
+static void set_feaclip_names(const ReprMethod& method, NumericMatrix& repr) {
+  if (method.type == ReprMethod::FEACLIP) {
+    colnames(repr) = CharacterVector::create("max_1", "sum_1", "max_0", "cross.", "f_0", "l_0", "f_1", "l_1");
+  }
+}
+
+static Rcpp::XPtr<ReprStream> stream_state(SEXP stream) {
+  return checked_xptr<ReprStream>(stream, "TSrepr_repr_stream", "stream must be created by repr_stream!");
+}
+
+// Creates the stream state for the method computed by repr_matrix engine
+// [[Rcpp::export]]
+SEXP repr_stream_native(std::string method, int win_size, int max_history, List args) {
+
+  if (win_size < 1) {
+    Rcpp::stop("win_size must be positive!");
+  }
+  if (max_history < 0) {
+    Rcpp::stop("max_history must be non-negative!");
+  }
+
+  Rcpp::XPtr<ReprStream> stream(new ReprStream(method, win_size, max_history, args), true,
+                                Rf_install("TSrepr_repr_stream"));
+
+  return stream;
+}
+
+//' @rdname repr_stream_update
+//' @name repr_stream_update
+//' @title Update of the stream of representations
+//'
+//' @description The \code{repr_stream_update} appends new values to the stream created by \code{\link[TSrepr]{repr_stream}}
+//' and returns representations of windows closed by these values.
+//' The \code{repr_stream_snapshot} returns representations of windows kept in the history of the stream and of the not closed window.
+//'
+//' @return \code{repr_stream_update} returns the numeric matrix of representations of closed windows (one row for every window),
+//' \code{repr_stream_snapshot} returns the numeric vector of representations of at most \code{max_history} last closed windows
+//' and of the not closed window (the same as \code{\link[TSrepr]{repr_windowing}} of all appended values,
+//' if no window was dropped from the history)
+//'
+//' @param stream the stream created by \code{repr_stream}
+//' @param x the numeric vector of new values of time series
+//'
+//' @details Appending of k values to the stream costs O(k) (representation of a window is computed once when the window is closed),
+//' independently on the number of values appended before.
+//' The snapshot contains also representation of values of the not closed window, if there are some.
+//' Representations of windows older than last \code{max_history} closed windows (see \code{\link[TSrepr]{repr_stream}})
+//' are dropped from the history, they are returned only once by \code{repr_stream_update}.
+//'
+//' @seealso \code{\link[TSrepr]{repr_stream}, \link[TSrepr]{repr_windowing}}
+//'
+//' @author Peter Laurinec, <tsreprpackage@gmail.com>
+//'
+//' @examples
+//' stream <- repr_stream(repr_feaclip, win_size = 24)
+//' repr_stream_update(stream, rnorm(30))
+//' repr_stream_update(stream, rnorm(30))
+//' repr_stream_snapshot(stream)
+//'
+//' @useDynLib TSrepr
+//' @export repr_stream_update
+// [[Rcpp::export]]
+NumericMatrix repr_stream_update(SEXP stream, NumericVector x) {
+
+  Rcpp::XPtr<ReprStream> state = stream_state(stream);
+
+  std::vector<double> closed;
+  int n_closed = state->update(x.begin(), x.size(), closed);
+  int win_repr = state->method.size(state->win_size);
+
+  NumericMatrix repr(n_closed, win_repr);
+
+  for(int i = 0; i < n_closed; i++){
+    for(int j = 0; j < win_repr; j++){
+      repr(i, j) = closed[i * win_repr + j];
+    }
+  }
+
+  set_feaclip_names(state->method, repr);
+
+  return repr;
+}
+
+//' @rdname repr_stream_update
+//' @export repr_stream_snapshot
+// [[Rcpp::export]]
+NumericVector repr_stream_snapshot(SEXP stream) {
+
+  Rcpp::XPtr<ReprStream> state = stream_state(stream);
+
+  int n_buffer = state->buffer.size();
+  // the open window has no representation if it is too short (SMA)
+  int n_open = n_buffer == 0 ? 0 : std::max(state->method.size(n_buffer), 0);
+
+  NumericVector repr(state->history.size() + n_open);
+
+  std::copy(state->history.begin(), state->history.end(), repr.begin());
+
+  if (n_open != 0) {
+    state->method.compute(state->buffer.data(), n_buffer, repr.begin() + state->history.size(), state->scratch);
+  }
+
+  return repr;
+}
+
+DftStream::DftStream(int win_size, int coef, bool coefficients, int recompute)
+  : win_size(win_size), coef(coef), recompute(recompute), coefficients(coefficients),
+    n_values(0), n_updates(0), buffer(win_size), pos(0), bins(coef), rotation(coef) {
+
+  for(int k = 0; k < coef; k++){
+    double angle = 2 * M_PI * k / win_size;
+    rotation[k] = std::complex<double>(std::cos(angle), std::sin(angle));
+  }
+}
+
+bool DftStream::update(double x) {
+
+  if (n_values < win_size) {
+    buffer[n_values++] = x;
+    if (n_values == win_size) {
+      exact();
+    }
+    return n_values == win_size;
+  }
+
+  double oldest = buffer[pos];
+  buffer[pos] = x;
+  pos = (pos + 1) % win_size;
+  n_values++;
+
+  if (++n_updates >= recompute) {
+    exact();
+  } else {
+    // X_k <- (X_k - oldest + x) * exp(2*pi*i*k/win_size)
+    for(int k = 0; k < coef; k++){
+      bins[k] = (bins[k] + (x - oldest)) * rotation[k];
+    }
+  }
+
+  return true;
+}
+
+void DftStream::exact() {
+  std::vector<double> window(win_size);
+
+  std::copy(buffer.begin() + pos, buffer.end(), window.begin());
+  std::copy(buffer.begin(), buffer.begin() + pos, window.begin() + (win_size - pos));
+
+  dft_bins(window.data(), win_size, coef, bins.data());
+  n_updates = 0;
+}
+
+int DftStream::size() const {
+  return coefficients ? 2 * coef : coef;
+}
+
+void DftStream::repr(double* out) const {
+  std::vector<std::complex<double> > current(bins);
+  dft_output(current.data(), coef, coefficients, out);
+}
+
+static Rcpp::XPtr<DftStream> dft_stream_state(SEXP stream) {
+  return checked_xptr<DftStream>(stream, "TSrepr_dft_stream", "stream must be created by dft_stream!");
+}
+
+// Creates the state of the sliding DFT
+// [[Rcpp::export]]
+SEXP dft_stream_native(int win_size, int coef, bool coefficients, int recompute) {
+
+  if (win_size < 1) {
+    Rcpp::stop("win_size must be positive!");
+  }
+  if (coef < 1 || coef > win_size) {
+    Rcpp::stop("coef must be between 1 and win_size!");
+  }
+  if (recompute < 1) {
+    Rcpp::stop("recompute must be positive!");
+  }
+
+  Rcpp::XPtr<DftStream> stream(new DftStream(win_size, coef, coefficients, recompute), true,
+                               Rf_install("TSrepr_dft_stream"));
+
+  return stream;
+}
+
+//' @rdname dft_stream_update
+//' @name dft_stream_update
+//' @title Update of the sliding DFT
+//'
+//' @description The \code{dft_stream_update} appends new values to the sliding DFT created by \code{\link[TSrepr]{dft_stream}}
+//' and returns DFT representations of all windows ended by these values.
+//' The \code{dft_stream_snapshot} returns DFT representation of the current window.
+//'
+//' @return \code{dft_stream_update} returns the numeric matrix of DFT representations (one row for every full window ended by new values),
+//' \code{dft_stream_snapshot} returns the numeric vector of DFT representation of the last \code{win_size} values
+//' (the same as \code{\link[TSrepr]{repr_dft}} of these values)
+//'
+//' @param stream the sliding DFT created by \code{dft_stream}
+//' @param x the numeric vector of new values of time series
+//'
+//' @seealso \code{\link[TSrepr]{dft_stream}, \link[TSrepr]{repr_dft}}
+//'
+//' @author Peter Laurinec, <tsreprpackage@gmail.com>
+//'
+//' @examples
+//' stream <- dft_stream(win_size = 24, coef = 4)
+//' dft_stream_update(stream, rnorm(30))
+//' dft_stream_snapshot(stream)
+//'
+//' @useDynLib TSrepr
+//' @export dft_stream_update
+// [[Rcpp::export]]
+NumericMatrix dft_stream_update(SEXP stream, NumericVector x) {
+
+  Rcpp::XPtr<DftStream> state = dft_stream_state(stream);
+
+  int n = x.size(), n_repr = state->size();
+  std::vector<double> reprs;
+
+  for(int i = 0; i < n; i++){
+    if (state->update(x[i])) {
+      reprs.resize(reprs.size() + n_repr);
+      state->repr(reprs.data() + (reprs.size() - n_repr));
+    }
+  }
+
+  int n_windows = reprs.size() / n_repr;
+  NumericMatrix repr(n_windows, n_repr);
+
+  for(int i = 0; i < n_windows; i++){
+    for(int j = 0; j < n_repr; j++){
+      repr(i, j) = reprs[(size_t) i * n_repr + j];
+    }
+  }
+
+  return repr;
+}
+
+//' @rdname dft_stream_update
+//' @export dft_stream_snapshot
+// [[Rcpp::export]]
+NumericVector dft_stream_snapshot(SEXP stream) {
+
+  Rcpp::XPtr<DftStream> state = dft_stream_state(stream);
+
+  if (state->n_values < state->win_size) {
+    Rcpp::stop("The window of the stream is not full!");
+  }
+
+  NumericVector repr(state->size());
+  state->repr(repr.begin());
+
+  return repr;
+}
@@ -0,0 +1,58 @@
+#ifndef TSREPR_REPRSTREAM_H
+#define TSREPR_REPRSTREAM_H
+
+#include <vector>
+#include <deque>
+#include <complex>
+#include <Rcpp.h>
+#include "reprMatrix.h"
+using namespace Rcpp;
+
+// Incremental windowing of a stream of values, representations of
+// non-overlapping windows of the length win_size are computed once
+// when the window is closed, values of the open window are buffered
+class ReprStream {
+public:
+  // args are kept to protect the aggregation function used by method
+  List args;
+  ReprMethod method;
+  int win_size, max_history, n_windows;
+  std::vector<double> buffer, scratch;
+  // representations of at most max_history last closed windows one after another
+  std::deque<double> history;
+
+  ReprStream(std::string method, int win_size, int max_history, List args);
+
+  // appends n values, representations of windows closed by them are
+  // appended to closed, returns the number of closed windows
+  int update(const double* x, int n, std::vector<double>& closed);
+};
+
+// Sliding DFT of the window of the last win_size values of a stream, leading
+// coef bins are updated in O(coef) by every new value and recomputed exactly
+// after every recompute updates to bound the floating-point drift
+class DftStream {
+public:
+  int win_size, coef, recompute;
+  bool coefficients;
+  // the number of appended values and updates since the exact computation
+  long long n_values;
+  int n_updates;
+  // values of the window in the circular buffer, pos is the oldest one
+  std::vector<double> buffer;
+  int pos;
+  std::vector<std::complex<double> > bins, rotation;
+
+  DftStream(int win_size, int coef, bool coefficients, int recompute);
+
+  // appends the value, returns true if the window is full
+  bool update(double x);
+  // representation of the full window as repr_dft
+  void repr(double* out) const;
+  int size() const;
+
+private:
+  void exact();
+};
+
+#endif
@@ -4,6 +4,28 @@
 #include "helpers.h"
 using namespace Rcpp;
 
+// SMA of a contiguous block, repr must have length n - order,
+// nothing is written if it is not positive
+void sma_kernel(const double* x, int n, int order, double* repr) {
+
+  int n_ma = n - order;
+  double sum = 0;
+
+  if (n_ma < 1) {
+    return;
+  }
+
+  for(int i = 0; i < order; i++){
+    sum += x[i];
+  }
+
+  repr[0] = sum / order;
+
+  for(int i = 1; i < n_ma; i++){
+    repr[i] = repr[i-1] + (x[i+order]/order) - (x[i-1]/order);
+  }
+}
+
 //' @rdname repr_sma
 //' @name repr_sma
 //' @title Simple Moving Average representation
@@ -27,21 +49,34 @@ NumericVector repr_sma(NumericVector x, int order) {
 
   int n = x.size();
   int n_ma = n - order;
-  double sum = 0;
+
+  if (order < 1) {
+    Rcpp::stop("order must be positive!");
+  }
+  if (n_ma < 1) {
+    Rcpp::stop("order must be less than the length of x!");
+  }
 
   NumericVector repr(n_ma);
 
-  for(int i = 0; i < order; i++){
-    sum += x[i];
-  }
+  sma_kernel(x.begin(), n, order, repr.begin());
 
-  repr[0] = sum / order;
+  return repr;
+}
 
-  for(int i = 1; i < n_ma; i++){
-    repr[i] = repr[i-1] + (x[i+order]/order) - (x[i-1]/order);
+// PAA of a contiguous block by a native aggregation kernel,
+// the last (shorter) piece aggregates the remainder of the series
+void paa_kernel(const double* x, int n, int q, Aggregation aggr, double* repr) {
+
+  int n_paa = n / q;
+
+  for(int i = 0; i < n_paa; i++){
+    repr[i] = aggr(x + (i*q), q);
   }
 
-  return repr;
+  if ((n % q) != 0) {
+    repr[n_paa] = aggr(x + (n_paa*q), n - (n_paa*q));
+  }
 }
 
 //' @rdname repr_paa
@@ -54,11 +89,17 @@ NumericVector repr_sma(NumericVector x, int order) {
 //'
 //' @param x the numeric vector (time series)
 //' @param q the integer of the length of the "piece"
-//' @param func the aggregation function. Can be meanC, medianC, sumC, minC or maxC or similar aggregation function
+//' @param func the aggregation function. Can be meanC, medianC, sumC, minC or maxC or similar aggregation function.
+//'  The name of the native aggregation as a character string (see \code{\link{aggr_names}}) or \code{\link{native_aggr}} can be used too.
 //'
 //' @details PAA with possibility to use arbitrary aggregation function.
 //' The original method uses average as aggregation function.
 //'
+//' The helper functions meanC, medianC, sumC, minC and maxC and native aggregations (their names, e.g. "sd" or "skewness",
+//' \code{\link{native_aggr}} or registered C++ functions, see \code{\link{register_aggr}}) are computed natively
+//' directly on the pieces of the time series, without calling R. Any other function is called
+//' from C++ for every piece, which is much slower for long time series.
+//'
 //' @seealso \code{\link[TSrepr]{repr_dwt}, \link[TSrepr]{repr_dft}, \link[TSrepr]{repr_dct}, \link[TSrepr]{repr_sma}}
 //'
 //' @author Peter Laurinec, <tsreprpackage@gmail.com>
@@ -70,10 +111,13 @@ NumericVector repr_sma(NumericVector x, int order) {
 //' @examples
 //' repr_paa(rnorm(11), 2, meanC)
 //'
+//' # the same with the name of the aggregation function
+//' repr_paa(rnorm(11), 2, "mean")
+//'
 //' @useDynLib TSrepr
 //' @export repr_paa
 // [[Rcpp::export]]
-NumericVector repr_paa(NumericVector x, int q, Rcpp::Function func) {
+NumericVector repr_paa(NumericVector x, int q, SEXP func) {
 
   int n = x.size();
   int n_paa = n/q;
@@ -84,6 +128,15 @@ NumericVector repr_paa(NumericVector x, int q, Rcpp::Function func) {
   }
 
   NumericVector repr(n_paa);
+
+  Aggregation aggr = find_aggr(func);
+
+  if (aggr != NULL) {
+    paa_kernel(x.begin(), n, q, aggr, repr.begin());
+    return repr;
+  }
+
+  Rcpp::Function r_func(func);
   IntegerVector sub_x(q);
   IntegerVector sub_rem(remain_count);
 
@@ -93,7 +146,7 @@ NumericVector repr_paa(NumericVector x, int q, Rcpp::Function func) {
       for(int j = 0; j < q; j++){
         sub_x[j] = (i*q) + j;
       }
-      repr[i] = Rcpp::as<double>(func(x[sub_x]));
+      repr[i] = Rcpp::as<double>(r_func(x[sub_x]));
     }
 
   } else {
@@ -102,19 +155,72 @@ NumericVector repr_paa(NumericVector x, int q, Rcpp::Function func) {
       for(int j = 0; j < q; j++){
         sub_x[j] = (i*q) + j;
       }
-      repr[i] = Rcpp::as<double>(func(x[sub_x]));
+      repr[i] = Rcpp::as<double>(r_func(x[sub_x]));
     }
 
     for(int j = 0; j < remain_count; j++){
       sub_rem[j] = ((n_paa-1)*q) + j;
     }
-    repr[n_paa-1] = Rcpp::as<double>(func(x[sub_rem]));
+    repr[n_paa-1] = Rcpp::as<double>(r_func(x[sub_rem]));
 
   }
 
   return repr;
 }
 
+// Seasonal profile computed by one linear sweep over x.
+// Mean, sum, min and max are accumulated per seasonal slot directly,
+// other aggregations get every slot gathered into a contiguous block first.
+void seas_profile_kernel(const double* x, int n, int freq, Aggregation aggr, double* repr) {
+
+  int freq_times_int = n / freq;
+  int remainder = n - (freq_times_int * freq);
+
+  if (aggr == aggr_mean || aggr == aggr_sum) {
+
+    std::fill(repr, repr + freq, 0.0);
+    for(int t = 0, i = 0; t < n; t++){
+      repr[i] += x[t];
+      if (++i == freq) i = 0;
+    }
+    if (aggr == aggr_mean) {
+      for(int i = 0; i < freq; i++){
+        repr[i] /= (i < remainder) ? freq_times_int + 1 : freq_times_int;
+      }
+    }
+
+  } else if ((aggr == aggr_min || aggr == aggr_max) && freq_times_int > 0) {
+
+    std::copy(x, x + freq, repr);
+    for(int t = freq, i = 0; t < n; t++){
+      if (aggr == aggr_min ? x[t] < repr[i] : x[t] > repr[i]) {
+        repr[i] = x[t];
+      }
+      if (++i == freq) i = 0;
+    }
+
+  } else {
+
+    std::vector<double> slots(n);
+    std::vector<int> start(freq + 1), pos(freq);
+    start[0] = 0;
+    for(int i = 0; i < freq; i++){
+      start[i + 1] = start[i] + ((i < remainder) ? freq_times_int + 1 : freq_times_int);
+      pos[i] = start[i];
+    }
+    for(int t = 0, i = 0; t < n; t++){
+      slots[pos[i]++] = x[t];
+      if (++i == freq) i = 0;
+    }
+    for(int i = 0; i < freq; i++){
+      if (start[i + 1] > start[i]) {
+        repr[i] = aggr(&slots[start[i]], start[i + 1] - start[i]);
+      } else repr[i] = NA_REAL;
+    }
+
+  }
+}
+
 //' @rdname repr_seas_profile
 //' @name repr_seas_profile
 //' @title Mean seasonal profile of time series
@@ -126,11 +232,15 @@ NumericVector repr_paa(NumericVector x, int q, Rcpp::Function func) {
 //' @param x the numeric vector (time series)
 //' @param freq the integer of the length of the season
 //' @param func the aggregation function. Can be meanC or medianC or similar aggregation function.
+//'  The name of the native aggregation as a character string (see \code{\link{aggr_names}}) or \code{\link{native_aggr}} can be used too.
 //'
 //' @details This function computes mean seasonal profile representation for a seasonal time series.
 //' The length of representation is length of set seasonality (frequency) of a time series.
 //' Aggregation function is arbitrary (best choice is for you maybe mean or median).
 //'
+//' The helper functions meanC, medianC, sumC, minC and maxC and native aggregations (see \code{\link{native_aggr}}) are computed natively
+//' by one pass through the time series (mean, sum, min and max) or on gathered seasonal slots. Any other function is called from C++ for every seasonal slot.
+//'
 //' @author Peter Laurinec, <tsreprpackage@gmail.com>
 //'
 //' @references Laurinec P, Lucka M (2016)
@@ -153,10 +263,19 @@ NumericVector repr_paa(NumericVector x, int q, Rcpp::Function func) {
 //' @useDynLib TSrepr
 //' @export repr_seas_profile
 // [[Rcpp::export]]
-NumericVector repr_seas_profile(NumericVector x, int freq, Rcpp::Function func) {
+NumericVector repr_seas_profile(NumericVector x, int freq, SEXP func) {
 
   NumericVector repr(freq);
   int n = x.size();
+
+  Aggregation aggr = find_aggr(func);
+
+  if (aggr != NULL) {
+    seas_profile_kernel(x.begin(), n, freq, aggr, repr.begin());
+    return repr;
+  }
+
+  Rcpp::Function r_func(func);
   // double freq_times = n / freq;
   int freq_times_int = n / freq;
   int remainder = n - (freq_times_int * freq);
@@ -170,7 +289,7 @@ NumericVector repr_seas_profile(NumericVector x, int freq, Rcpp::Function func)
       for(int j = 0; j < freq_times_int; j++){
         ind[j] = (j*freq) + i;
       }
-      repr[i] = Rcpp::as<double>(func(x[ind]));
+      repr[i] = Rcpp::as<double>(r_func(x[ind]));
     }
   } else {
     for(int i = 0; i < freq; i++){
@@ -184,7 +303,7 @@ NumericVector repr_seas_profile(NumericVector x, int freq, Rcpp::Function func)
       for(int j = 0; j < n_times; j++){
         ind[j] = (j*freq) + i;
       }
-      repr[i] = Rcpp::as<double>(func(x[ind]));
+      repr[i] = Rcpp::as<double>(r_func(x[ind]));
     }
   }
 
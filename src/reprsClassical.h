@@ -1,6 +1,16 @@
+#ifndef TSREPR_REPRSCLASSICAL_H
+#define TSREPR_REPRSCLASSICAL_H
+
 #include <Rcpp.h>
+#include "helpers.h"
 using namespace Rcpp;
 
 NumericVector repr_sma(NumericVector x, int order);
-NumericVector repr_paa(NumericVector x, int q, Rcpp::Function func);
-NumericVector repr_seas_profile(NumericVector x, int freq, Rcpp::Function func);
+NumericVector repr_paa(NumericVector x, int q, SEXP func);
+NumericVector repr_seas_profile(NumericVector x, int freq, SEXP func);
+
+void sma_kernel(const double* x, int n, int order, double* repr);
+void paa_kernel(const double* x, int n, int q, Aggregation aggr, double* repr);
+void seas_profile_kernel(const double* x, int n, int freq, Aggregation aggr, double* repr);
+
+#endif
@@ -1,8 +1,78 @@
+#include <map>
+#include <vector>
 #include <numeric>
 #include <algorithm>
+#include <cmath>
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
 #include <Rcpp.h>
+#include "bitLevel.h"
+#include "rle.h"
 using namespace Rcpp;
 
+// Neighbouring values are compared by SSE2 by 4 integers or 2 doubles at once,
+// masks of equal lanes are gathered by movemask, remaining pairs one by one
+uint64_t rle_boundaries(const int* x, int from, int n) {
+  int m = std::min(64, n - 1 - from), b = 0;
+  uint64_t mask = 0;
+
+#if defined(__SSE2__)
+  const __m128i na = _mm_set1_epi32(NA_INTEGER);
+  for(; b + 4 <= m; b += 4){
+    __m128i a = _mm_loadu_si128((const __m128i*) (x + from + b));
+    __m128i c = _mm_loadu_si128((const __m128i*) (x + from + b + 1));
+    __m128i same = _mm_andnot_si128(_mm_cmpeq_epi32(a, na), _mm_cmpeq_epi32(a, c));
+    mask |= (uint64_t) (~_mm_movemask_ps(_mm_castsi128_ps(same)) & 0xF) << b;
+  }
+#endif
+
+  for(; b < m; b++){
+    int a = x[from + b];
+    mask |= (uint64_t) (a != x[from + b + 1] || a == NA_INTEGER) << b;
+  }
+
+  return mask;
+}
+
+uint64_t rle_boundaries(const double* x, int from, int n) {
+  int m = std::min(64, n - 1 - from), b = 0;
+  uint64_t mask = 0;
+
+#if defined(__SSE2__)
+  for(; b + 2 <= m; b += 2){
+    __m128d a = _mm_loadu_pd(x + from + b), c = _mm_loadu_pd(x + from + b + 1);
+    mask |= (uint64_t) (~_mm_movemask_pd(_mm_cmpeq_pd(a, c)) & 0x3) << b;
+  }
+#endif
+
+  // NaN is not equal to anything
+  for(; b < m; b++){
+    mask |= (uint64_t) !(x[from + b] == x[from + b + 1]) << b;
+  }
+
+  return mask;
+}
+
+// runs are counted first, so outputs are allocated once
+template <typename T, typename V>
+static List rle_vector(const T* x, int n) {
+  int N = rle_count(x, n), j = 0;
+  IntegerVector lengths(N);
+  V values(N);
+
+  rle_runs(x, n, [&](int start, int length) {
+    lengths[j] = length;
+    values[j] = x[start];
+    j++;
+  });
+
+  return List::create(
+    _["lengths"] = lengths,
+    _["values"] = values
+  );
+}
+
 //' @rdname rleC
 //' @name rleC
 //' @title RLE (Run Length Encoding) written in C++
@@ -11,7 +81,15 @@ using namespace Rcpp;
 //'
 //' @return the list of values and counts of zeros and ones
 //'
-//' @param x the integer vector (from \code{clipping} or \code{trending})
+//' @param x the integer vector (from \code{clipping} or \code{trending}), or the logical or numeric vector,
+//' or the bit-packed representation (from \code{clipping_packed} or \code{trending_packed})
+//'
+//' @details Values keep the type of x (integer values of bit-packed representations), lengths are integers.
+//' Run boundaries are found by comparisons of neighbouring values by SIMD instructions (when available)
+//' in blocks of 64 values, runs are counted first, so the output is allocated only once.
+//' Missing values are runs of the length one as in \code{\link[base]{rle}}.
+//'
+//' @seealso \code{\link[TSrepr]{rle_decode}, \link[TSrepr]{rle_stats}, \link[TSrepr]{rle_packed}}
 //'
 //' @examples
 //' # clipping
@@ -24,32 +102,223 @@ using namespace Rcpp;
 //' @useDynLib TSrepr
 //' @export rleC
 // [[Rcpp::export]]
-List rleC(NumericVector x) {
+List rleC(SEXP x) {
 
-  std::vector<int> lengths;
-  std::vector<double> values;
+  switch (TYPEOF(x)) {
+  case INTSXP: {
+    IntegerVector v(x);
+    return rle_vector<int, IntegerVector>(v.begin(), v.size());
+  }
+  case LGLSXP: {
+    LogicalVector v(x);
+    return rle_vector<int, LogicalVector>(v.begin(), v.size());
+  }
+  case REALSXP: {
+    NumericVector v(x);
+    return rle_vector<double, NumericVector>(v.begin(), v.size());
+  }
+  case RAWSXP:
+    return rle_packed(RawVector(x));
+  }
+
+  Rcpp::stop("x must be integer, logical, numeric or bit-packed vector!");
+  return List();
+}
+
+template <typename V>
+static V rle_decode_values(V values, IntegerVector lengths) {
+  size_t n = 0;
+
+  for(int i = 0; i < lengths.size(); i++){
+    if (lengths[i] == NA_INTEGER || lengths[i] < 0) {
+      Rcpp::stop("lengths must be non-negative integers!");
+    }
+    n += lengths[i];
+  }
+
+  V x(n);
+  typename V::iterator it = x.begin();
+
+  for(int i = 0; i < lengths.size(); i++){
+    std::fill(it, it + lengths[i], values[i]);
+    it += lengths[i];
+  }
 
-  // Initialise first value
-  int i = 0;
-  double prev = x[0];
-  values.push_back(prev);
-  lengths.push_back(1);
+  return x;
+}
 
-  NumericVector::iterator it;
-  for(it = x.begin() + 1; it != x.end(); ++it) {
-    if (prev == *it) {
-      lengths[i]++;
+//' @rdname rle_decode
+//' @name rle_decode
+//' @title Decodes RLE (Run Length Encoding)
+//'
+//' @description The \code{rle_decode} creates the vector from its RLE, it is the inverse of \code{\link[TSrepr]{rleC}}.
+//'
+//' @return the vector of the type of values
+//'
+//' @param x the list of lengths and values (from \code{rleC})
+//'
+//' @seealso \code{\link[TSrepr]{rleC}}
+//'
+//' @author Peter Laurinec, <tsreprpackage@gmail.com>
+//'
+//' @examples
+//' clipped <- clipping(rnorm(50))
+//' rle_decode(rleC(clipped))
+//'
+//' @useDynLib TSrepr
+//' @export rle_decode
+// [[Rcpp::export]]
+SEXP rle_decode(List x) {
+
+  IntegerVector lengths = x["lengths"];
+  SEXP values = x["values"];
+
+  if (lengths.size() != Rf_length(values)) {
+    Rcpp::stop("lengths and values must have the same length!");
+  }
+
+  switch (TYPEOF(values)) {
+  case INTSXP:
+    return rle_decode_values(IntegerVector(values), lengths);
+  case LGLSXP:
+    return rle_decode_values(LogicalVector(values), lengths);
+  case REALSXP:
+    return rle_decode_values(NumericVector(values), lengths);
+  }
+
+  Rcpp::stop("values must be integer, logical or numeric vector!");
+  return R_NilValue;
+}
+
+// Statistics of runs of every value, runs of NA values are counted together
+struct RunStats {
+  int runs, max, sum;
+
+  RunStats() : runs(0), max(0), sum(0) {}
+
+  void add(int length) {
+    runs++;
+    max = std::max(max, length);
+    sum += length;
+  }
+};
+
+static bool rle_na(int x) {
+  return x == NA_INTEGER;
+}
+
+static bool rle_na(double x) {
+  return std::isnan(x);
+}
+
+template <typename T>
+class RunStatsTable {
+public:
+  std::map<T, RunStats> table;
+  RunStats na;
+
+  void add(T value, int length) {
+    if (rle_na(value)) {
+      na.add(length);
     } else {
-      values.push_back(*it);
-      lengths.push_back(1);
+      table[value].add(length);
+    }
+  }
+
+  // values are sorted, NA is the last one
+  template <typename V>
+  List output(T na_value) const {
+    int N = table.size() + (na.runs > 0);
+    V values(N);
+    IntegerVector runs(N), max(N), sum(N);
+    int j = 0;
 
-      i++;
-      prev = *it;
+    for(typename std::map<T, RunStats>::const_iterator it = table.begin(); it != table.end(); ++it, j++){
+      values[j] = it->first;
+      runs[j] = it->second.runs;
+      max[j] = it->second.max;
+      sum[j] = it->second.sum;
+    }
+    if (na.runs > 0) {
+      values[j] = na_value;
+      runs[j] = na.runs;
+      max[j] = na.max;
+      sum[j] = na.sum;
     }
+
+    return List::create(
+      _["values"] = values,
+      _["runs"] = runs,
+      _["max"] = max,
+      _["sum"] = sum
+    );
   }
+};
 
-  return List::create(
-    _["lengths"] = lengths,
-    _["values"] = values
-  );
+template <typename T, typename V>
+static List rle_stats_vector(const T* x, int n, T na_value) {
+  RunStatsTable<T> stats;
+
+  rle_runs(x, n, [&](int start, int length) {
+    stats.add(x[start], length);
+  });
+
+  return stats.template output<V>(na_value);
+}
+
+//' @rdname rle_stats
+//' @name rle_stats
+//' @title Statistics of runs of RLE (Run Length Encoding)
+//'
+//' @description The \code{rle_stats} computes the number of runs, the maximal run length and the sum of run lengths
+//' of every value of the vector without materialising its RLE.
+//'
+//' @return the list of sorted values (\code{values}, NA is the last one), numbers of their runs (\code{runs}),
+//' maximal lengths of their runs (\code{max}) and sums of lengths of their runs (\code{sum})
+//'
+//' @param x the integer, logical or numeric vector, or the bit-packed representation
+//' (from \code{clipping_packed} or \code{trending_packed})
+//'
+//' @details Runs are found as in \code{\link[TSrepr]{rleC}}, so statistics are the same as statistics
+//' of lengths of \code{rleC(x)} grouped by values. Features of \code{\link[TSrepr]{repr_feaclip}}
+//' (\code{max_1}, \code{sum_1}, \code{max_0} and the number of crossings) are statistics of runs of the clipped representation.
+//'
+//' @seealso \code{\link[TSrepr]{rleC}, \link[TSrepr]{repr_feaclip}}
+//'
+//' @author Peter Laurinec, <tsreprpackage@gmail.com>
+//'
+//' @examples
+//' rle_stats(clipping(rnorm(50)))
+//' rle_stats(clipping_packed(rnorm(50)))
+//'
+//' @useDynLib TSrepr
+//' @export rle_stats
+// [[Rcpp::export]]
+List rle_stats(SEXP x) {
+
+  switch (TYPEOF(x)) {
+  case INTSXP: {
+    IntegerVector v(x);
+    return rle_stats_vector<int, IntegerVector>(v.begin(), v.size(), NA_INTEGER);
+  }
+  case LGLSXP: {
+    LogicalVector v(x);
+    return rle_stats_vector<int, LogicalVector>(v.begin(), v.size(), NA_LOGICAL);
+  }
+  case REALSXP: {
+    NumericVector v(x);
+    return rle_stats_vector<double, NumericVector>(v.begin(), v.size(), NA_REAL);
+  }
+  case RAWSXP: {
+    BitLevel bits = bits_from_r(RawVector(x));
+    RunStatsTable<int> stats;
+    bits.runs([&](int value, int length) {
+      stats.add(value, length);
+    });
+    return stats.output<IntegerVector>(NA_INTEGER);
+  }
+  }
+
+  Rcpp::stop("x must be integer, logical, numeric or bit-packed vector!");
+  return List();
 }
@@ -1,4 +1,52 @@
+#ifndef TSREPR_RLE_H
+#define TSREPR_RLE_H
+
+#include <stdint.h>
 #include <Rcpp.h>
+#include "bitLevel.h"
 using namespace Rcpp;
 
-List rleC(NumericVector y);
+// Boundaries of runs of the block of (at most) 64 pairs of neighbouring values
+// starting at from, the bit b is set when the run ends at from + b (x[from + b]
+// differs from x[from + b + 1]). NA values are runs of the length one as in rle.
+uint64_t rle_boundaries(const int* x, int from, int n);
+uint64_t rle_boundaries(const double* x, int from, int n);
+
+// the number of runs of x
+template <typename T>
+int rle_count(const T* x, int n) {
+  if (n == 0) {
+    return 0;
+  }
+
+  int count = 1;
+  for(int from = 0; from < n - 1; from += 64){
+    count += popcount64(rle_boundaries(x, from, n));
+  }
+
+  return count;
+}
+
+// calls f(start, length) for every run of x
+template <typename T, typename F>
+void rle_runs(const T* x, int n, F f) {
+  int start = 0;
+
+  for(int from = 0; from < n - 1; from += 64){
+    uint64_t mask = rle_boundaries(x, from, n);
+    while (mask != 0) {
+      int end = from + ctz64(mask) + 1;
+      f(start, end - start);
+      start = end;
+      mask &= mask - 1;
+    }
+  }
+
+  if (n > 0) {
+    f(start, n - start);
+  }
+}
+
+List rleC(SEXP x);
+
+#endif